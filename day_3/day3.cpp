@@ -5,11 +5,23 @@
 #include<algorithm>
 #include<numeric>
 #include<fstream>
+#include<sstream>
 #include<tuple>
 #include<chrono>
-
-
-const std::string NUMERICCHARACTERS = "0123456789";
+#include<functional>
+#include<thread>
+#include<mutex>
+#include<memory>
+#include<array>
+#include<string_view>
+#include<cstdint>
+#include<cstring>
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<unistd.h>
+#ifdef __AVX2__
+#include<immintrin.h>
+#endif
 
 
 /**
@@ -79,72 +91,199 @@ T multiplyAllElements(  std::vector<T> vec,
 
 
 /**
- * The object which stores the data of a single point on the EngineSchematic grid.
+ * Character classification for the engine schematic.
+ * . is nothing, [0123456789] is a number, and anything other than [.0123456789] is a symbol.
 */
-class EnginePosition
+bool isSchematicDigit( const char c )
 {
-    public:
-        /*** Member variables ***/
-        char character;
-        std::string type;
-        int row;
-        int col;
+    return (c >= '0') && (c <= '9');
+}
 
-        /*** Constructors ***/
-        //Default
-        EnginePosition()
+bool isSchematicSymbol( const char c )
+{
+    return (c != '.') && !isSchematicDigit(c);
+}
+
+
+/**
+ * The type of a single position on the EngineSchematic grid.
+*/
+enum class PositionType : unsigned char { NOTHING, NUMBER, SYMBOL };
+
+
+/**
+ * Build the lookup table that maps every byte to its PositionType, so classifying a position is a single load.
+*/
+constexpr std::array<PositionType, 256> buildPositionTypeTable()
+{
+    std::array<PositionType, 256> table = {};
+    for(int c = 0; c < 256; c++)
+    {
+        if(c == '.')
         {
-            character = '.';
-            type = "nothing";
-            row = 0;
-            col = 0;
+            table[c] = PositionType::NOTHING;
         }
-    
-        //Parametric
-        EnginePosition( char characterParam,
-                        int rowParam,
-                        int colParam )
+        else if( (c >= '0') && (c <= '9') )
+        {
+            table[c] = PositionType::NUMBER;
+        }
+        else
+        {
+            table[c] = PositionType::SYMBOL;
+        }
+    }
+    return table;
+}
+
+constexpr std::array<PositionType, 256> POSITIONTYPES = buildPositionTypeTable();
+
+
+/**
+ * A number on the engine schematic grid. Each number occupies the columns colStart through colEnd (inclusive) of a
+ * single row.
+*/
+struct NumberSpan
+{
+    int row;
+    int colStart;
+    int colEnd;
+    long long int value;
+    bool isPartNumber = false; //Whether any symbol is adjacent to the number
+};
+
+
+/**
+ * The coordinates of every symbol on the engine schematic grid, stored as separate row and col columns. The symbol at
+ * index i is at (rows[i], cols[i]).
+*/
+struct SymbolCoordinates
+{
+    std::vector<int> rows;
+    std::vector<int> cols;
+
+    int size() const
+    {
+        return rows.size();
+    }
+};
+
+
+/**
+ * Per-query scratch state: a bitset recording which numbers (by their index in EngineSchematic::numberSpans) a query
+ * has already visited. Queries keep this outside of the schematic so the schematic itself is never written to.
+*/
+class SpanVisitSet
+{
+    public:
+        /**
+         * Clear the set and make room for spanCount numbers.
+        */
+        void reset( int spanCount )
         {
-            character = characterParam;
-            type = getPositionType(character);
-            row = rowParam;
-            col = colParam;
+            words.assign((spanCount + 63) / 64, 0);
         }
 
-        /*** Methods***/
         /**
-         * Given a character, determine what type of engine position corresponds
-         * to the character.
-         * 
-         * . returns "nothing"
-         * [0123456789] returns "partNumber"
-         * Anything other than [.0123456789] returns "symbol"
-         * 
-         * Parameter:
-         *  const char characterParam - The character we are evaluating to find its type.
-         * 
-         * Returns:
-         *  std::string - Indicates the type of EnginePosition for the given characterParam.
+         * Mark a number as visited. Returns true if it had not been visited before.
         */
-        std::string getPositionType( const char characterParam )
+        bool visit( int spanId )
+        {
+            unsigned long long bit = 1ull << (spanId % 64);
+            bool firstVisit = (words[spanId / 64] & bit) == 0;
+            words[spanId / 64] |= bit;
+            return firstVisit;
+        }
+
+    private:
+        std::vector<unsigned long long> words;
+};
+
+
+/**
+ * A thread-safe pool of SpanVisitSets, so that concurrent queries each get their own scratch state without
+ * allocating a new bitset every time. acquire() hands out a set that goes back to the pool when it is destroyed.
+*/
+class SpanVisitSetPool
+{
+    public:
+        //Returns the set to the pool it came from when it goes out of scope
+        struct Deleter
         {
-            if(characterParam == '.')
+            SpanVisitSetPool * pool;
+            void operator()( SpanVisitSet * visitSet ) const
             {
-                return "nothing";
+                pool->release(visitSet);
             }
-            else if( NUMERICCHARACTERS.find(characterParam) != std::string::npos )
+        };
+        using Handle = std::unique_ptr<SpanVisitSet, Deleter>;
+
+        /**
+         * Take a cleared SpanVisitSet with room for spanCount numbers from the pool, creating one if the pool is empty.
+        */
+        Handle acquire( int spanCount )
+        {
+            SpanVisitSet * visitSet = nullptr;
             {
-                return "number";
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!freeSets.empty())
+                {
+                    visitSet = freeSets.back().release();
+                    freeSets.pop_back();
+                }
             }
-            else
+            if(visitSet == nullptr)
             {
-                return "symbol";
+                visitSet = new SpanVisitSet();
             }
+            visitSet->reset(spanCount);
+            return Handle(visitSet, Deleter{this});
         }
 
-        
     private:
+        std::mutex mutex;
+        std::vector< std::unique_ptr<SpanVisitSet> > freeSets;
+
+        void release( SpanVisitSet * visitSet )
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            freeSets.emplace_back(visitSet);
+        }
+};
+
 
+/**
+ * Options for EngineSchematic::querySymbols.
+ *
+ * AdjacencyArity::EXACTLY - The symbol must be adjacent to exactly arity numbers.
+ * AdjacencyArity::AT_LEAST - The symbol must be adjacent to arity or more numbers.
+ *
+ * SpanAggregate::SUM - A matching symbol's value is the sum of its adjacent numbers.
+ * SpanAggregate::PRODUCT - A matching symbol's value is the product of its adjacent numbers.
+ * SpanAggregate::LIST - A matching symbol's adjacent numbers are listed in full.
+*/
+enum class AdjacencyArity { EXACTLY, AT_LEAST };
+enum class SpanAggregate { SUM, PRODUCT, LIST };
+
+struct SymbolQuery
+{
+    std::string symbols = "*"; //The symbol characters we are interested in
+    int arity = 2; //The number of adjacent numbers a symbol needs to match
+    AdjacencyArity arityMode = AdjacencyArity::EXACTLY;
+    SpanAggregate aggregate = SpanAggregate::PRODUCT;
+};
+
+struct SymbolQueryMatch
+{
+    int row;
+    int col;
+    long long int value; //The sum or product of the adjacent numbers. Unused for SpanAggregate::LIST.
+    std::vector<long long int> spanValues; //The adjacent numbers. Only filled in for SpanAggregate::LIST.
+};
+
+struct SymbolQueryResult
+{
+    long long int total = 0; //The sum of all match values, or the number of matches for SpanAggregate::LIST
+    std::vector<SymbolQueryMatch> matches = {};
 };
 
 
@@ -152,30 +291,75 @@ class EnginePosition
  * An object representing the engine schematic for the advent of code 2023 day 3 problem.
  * It is fundamentally a 2D grid where each point on the grid is occupied by nothing (a period .),
  * a symbol (Defined as not a period or a number), or a number (0,1,2,3,4,5,6,7,8,9).
+ * The grid is stored flat in row-major order: the position (row, col) is at index row * width + col.
+ *
+ * All of the query methods are const and keep their scratch state outside of the schematic, so one loaded schematic
+ * can serve queries from many threads at once. setCell is the only method that modifies a schematic, and it must not
+ * run at the same time as any query.
 */
 class EngineSchematic
 {
     public:
         /*** Member variables ***/
-        std::vector< std::vector< EnginePosition > > grid;
-        std::vector< std::tuple<int,int> > symbolPositions;
+        int width = 0;
+        int height = 0;
+        std::string cells; //The character at each grid position
+        std::vector< PositionType > types; //The type of each grid position
+        SymbolCoordinates symbolPositions;
+        std::vector< NumberSpan > numberSpans; //Every number on the grid
+        std::vector<int> spanIds; //For each grid position, the index of its number in numberSpans, or -1
+        std::vector< std::vector<int> > symbolAdjacency; //For each symbol in symbolPositions, the numberSpans indices adjacent to it
+        std::vector<int> symbolIds; //For each grid position, the index of its symbol in symbolPositions, or -1
+        std::vector< long long int > gearRatios; //For each symbol in symbolPositions, its gear ratio, or 0 if it isn't a gear
+        long long int partNumberSum = 0; //Kept up to date by setCell
+        long long int gearRatioSum = 0; //Kept up to date by setCell
+        std::shared_ptr<SpanVisitSetPool> visitSetPool = std::make_shared<SpanVisitSetPool>(); //Scratch state for queries
         
         /*** Constructors ***/
         //Default
         EngineSchematic()
         {
-            grid = {};
         }
 
-        //Parametric
-        EngineSchematic( std::vector< std::vector< EnginePosition > > gridParam)
+        //Parametric. cellsParam holds width * height characters in row-major order, and is moved from.
+        EngineSchematic(    std::string cellsParam,
+                            int widthParam,
+                            int heightParam )
         {
-            grid = gridParam;
-            symbolPositions = findSymbolPositions(grid);
+            width = widthParam;
+            height = heightParam;
+            cells = std::move(cellsParam);
+            //Classify every position with the lookup table
+            types.resize(cells.size());
+            for(int i = 0; i < cells.size(); i++)
+            {
+                types[i] = POSITIONTYPES[(unsigned char)cells[i]];
+            }
+            symbolPositions = findSymbolPositions();
+            buildSymbolAdjacency();
         }
 
 
         /*** Methods ***/
+        /**
+         * Given the row and col of a grid position, return its index in cells, types, spanIds and symbolIds.
+        */
+        int cellIndex(  int row,
+                        int col ) const
+        {
+            return (row * width) + col;
+        }
+
+
+        /**
+         * Given a row of the grid, return a view of its characters.
+        */
+        std::string_view rowView( int row ) const
+        {
+            return std::string_view(cells.data() + cellIndex(row, 0), width);
+        }
+
+
         /**
          * Given a tuple of integers representing the row and col coordinates of a position on the engine schematic grid,
          * return a vector containing tuple<int,int> coordinates for all adjacent numbers to the passed in coordinates.
@@ -184,79 +368,59 @@ class EngineSchematic
          *  tuple<int,int> coordinates - The coordinates on the engine schematic grid we'd like to look around to find all of the adjacent numbers.
          * 
          * Returns:
-         *  std::vector< tuple<int,int> > - A vector containing all of the coordinates adjacent to the passed in coordinates which are EnginePositions with type "number"
+         *  std::vector< tuple<int,int> > - A vector containing all of the coordinates adjacent to the passed in coordinates which are positions with type PositionType::NUMBER
         */
-        std::vector< std::tuple<int,int> > getAdjacentNumbersToPosition( std::tuple<int,int> coordinates )
+        std::vector< std::tuple<int,int> > getAdjacentNumbersToPosition( std::tuple<int,int> coordinates ) const
         {
             //Initialize the vector we'll be returning
             std::vector< std::tuple<int,int> > adjacentNumberCoordinates = {};
             //Make some more readable vars
             int targetRow = std::get<0>(coordinates);
             int targetCol = std::get<1>(coordinates);
+            bool hasNorth = targetRow > 0;
+            bool hasSouth = targetRow < height - 1;
+            bool hasWest = targetCol > 0;
+            bool hasEast = targetCol < width - 1;
 
             //North
-            if(targetRow > 0)
+            if( hasNorth && (types[cellIndex(targetRow - 1, targetCol)] == PositionType::NUMBER) )
             {
-                if(grid[targetRow - 1][targetCol].type == "number")
-                {
-                    adjacentNumberCoordinates.push_back( std::make_tuple( targetRow - 1, targetCol));
-                }
+                adjacentNumberCoordinates.push_back( std::make_tuple( targetRow - 1, targetCol) );
             }
             //Northeast
-            if( (targetRow > 0) && (targetCol < grid[targetRow].size()) )
+            if( hasNorth && hasEast && (types[cellIndex(targetRow - 1, targetCol + 1)] == PositionType::NUMBER) )
             {
-                if(grid[targetRow - 1][targetCol + 1].type == "number")
-                {
-                    adjacentNumberCoordinates.push_back( std::make_tuple( targetRow - 1, targetCol + 1));
-                }
+                adjacentNumberCoordinates.push_back( std::make_tuple( targetRow - 1, targetCol + 1) );
             }
             //East
-            if( targetCol < grid[targetRow].size() )
+            if( hasEast && (types[cellIndex(targetRow, targetCol + 1)] == PositionType::NUMBER) )
             {
-                if(grid[targetRow][targetCol + 1].type == "number")
-                {
-                    adjacentNumberCoordinates.push_back( std::make_tuple( targetRow, targetCol + 1));
-                }
+                adjacentNumberCoordinates.push_back( std::make_tuple( targetRow, targetCol + 1) );
             }
             //Southeast
-            if( (targetRow > 0) && (targetCol < grid[targetRow].size()) )
+            if( hasSouth && hasEast && (types[cellIndex(targetRow + 1, targetCol + 1)] == PositionType::NUMBER) )
             {
-                if( grid[targetRow + 1][targetCol + 1].type == "number" )
-                {
-                    adjacentNumberCoordinates.push_back( std::make_tuple( targetRow + 1, targetCol + 1) );
-                }
+                adjacentNumberCoordinates.push_back( std::make_tuple( targetRow + 1, targetCol + 1) );
             }
             //South
-            if( targetRow > 0 )
+            if( hasSouth && (types[cellIndex(targetRow + 1, targetCol)] == PositionType::NUMBER) )
             {
-                if( grid[targetRow + 1][targetCol].type == "number" )
-                {
-                    adjacentNumberCoordinates.push_back( std::make_tuple( targetRow + 1, targetCol) );
-                }
+                adjacentNumberCoordinates.push_back( std::make_tuple( targetRow + 1, targetCol) );
             }
             //Southwest
-            if( (targetRow > 0 ) && (targetCol > 0) )
+            if( hasSouth && hasWest && (types[cellIndex(targetRow + 1, targetCol - 1)] == PositionType::NUMBER) )
             {
-                if( grid[targetRow + 1][targetCol - 1].type == "number" )
-                {
-                    adjacentNumberCoordinates.push_back( std::make_tuple( targetRow + 1, targetCol - 1) );
-                }
+                adjacentNumberCoordinates.push_back( std::make_tuple( targetRow + 1, targetCol - 1) );
             }
             //West
-            if( targetCol > 0 )
+            if( hasWest && (types[cellIndex(targetRow, targetCol - 1)] == PositionType::NUMBER) )
             {
-                if( grid[targetRow][targetCol - 1].type == "number")
-                {
-                    adjacentNumberCoordinates.push_back( std::make_tuple( targetRow, targetCol - 1) );
-                }
+                adjacentNumberCoordinates.push_back( std::make_tuple( targetRow, targetCol - 1) );
             }
             //Northwest
-            if( (targetRow > 0) && (targetCol > 0) )
+            if( hasNorth && hasWest && (types[cellIndex(targetRow - 1, targetCol - 1)] == PositionType::NUMBER) )
             {
-                if( grid[targetRow - 1][targetCol - 1].type == "number")
-                {
-                    adjacentNumberCoordinates.push_back( std::make_tuple( targetRow - 1, targetCol - 1) );
-                }
+                adjacentNumberCoordinates.push_back( std::make_tuple( targetRow - 1, targetCol - 1) );
             }
 
             return adjacentNumberCoordinates;
@@ -264,228 +428,1296 @@ class EngineSchematic
 
 
         /**
-         * Given the coordinates of a number on the engine schematic grid, look to the left and right of the number to find the whole
-         * number, setting each of the positions we find that are of type "number" to type "partNumber". We concatenate all of these 
-         * adjacent numbers to the numberCoordinates to form the whole part number, convert it to an integer, and return it.
+         * Given the coordinates of any digit of a number on the engine schematic grid, return the whole number.
          * 
          * Paramter:
-         *  std::tuple<int,int> numberCoordinates - The coordinates of an engine of type "number" that we have identified to be a part number.
+         *  std::tuple<int,int> numberCoordinates - The coordinates of a position of type NUMBER that we have identified to be a part number.
          * 
          * Returns:
-         *  int - The integer representation of the part number.
+         *  long long int - The integer representation of the part number.
+        */
+        long long int findCompletePartNumber( std::tuple<int,int> numberCoordinates ) const
+        {
+            return numberSpans[spanIdAt(numberCoordinates)].value;
+        }
+
+
+        /**
+         * Given the coordinates of any digit of a number on the engine schematic grid, return the index of the number
+         * in numberSpans.
+        */
+        int spanIdAt( std::tuple<int,int> numberCoordinates ) const
+        {
+            return spanIds[cellIndex(std::get<0>(numberCoordinates), std::get<1>(numberCoordinates))];
+        }
+
+
+        /**
+         * Get scratch state for a query that needs to keep track of which numbers it has already visited. The
+         * returned set is cleared, and goes back to the schematic's pool when it goes out of scope.
         */
-        int findCompletePartNumber( std::tuple<int,int> numberCoordinates )
+        SpanVisitSetPool::Handle acquireSpanVisitSet() const
         {
-            //std::cout << "Calling find complete number on row " << std::get<0>(numberCoordinates) << " col " << std::get<1>(numberCoordinates) << std::endl;
+            return visitSetPool->acquire(numberSpans.size());
+        }
 
-            //Start the string representation of our partNumber
-            std::string partNumber_str = "";
-            partNumber_str += grid[std::get<0>(numberCoordinates)][std::get<1>(numberCoordinates)].character;
-            //Set the EnginePosition at numberCoordinates to be a partNumber
-            grid[std::get<0>(numberCoordinates)][std::get<1>(numberCoordinates)].type = "partNumber";
-            //std::cout << partNumber_str << std::endl;
 
-            //Look to the right of the EnginePosition at numberCoordindates
-            for(int col = (std::get<1>(numberCoordinates)+1); col < grid.size(); col++)
+        /**
+         * Find every symbol matching the query and aggregate the numbers adjacent to it. This only reads the symbol
+         * adjacency lists built when the schematic was constructed, so any number of queries can be run against a
+         * schematic without walking (or modifying) the grid again.
+         *
+         * Parameter:
+         *  const SymbolQuery & query - Which symbols to look for, how many adjacent numbers they need, and how to aggregate those numbers.
+         *
+         * Returns:
+         *  SymbolQueryResult - Every matching symbol along with its aggregate, and the total across all matching symbols.
+        */
+        SymbolQueryResult querySymbols( const SymbolQuery & query ) const
+        {
+            SymbolQueryResult result;
+            //Build a lookup table for the symbol set
+            bool isQueriedSymbol[256] = {};
+            for(unsigned char c : query.symbols)
+            {
+                isQueriedSymbol[c] = true;
+            }
+
+            for(int i = 0; i < symbolPositions.size(); i++)
             {
-                if(grid[std::get<0>(numberCoordinates)][col].type == "number")
+                int row = symbolPositions.rows[i];
+                int col = symbolPositions.cols[i];
+                if(!isQueriedSymbol[(unsigned char)cells[cellIndex(row, col)]])
                 {
-                    partNumber_str += grid[std::get<0>(numberCoordinates)][col].character;
-                    grid[std::get<0>(numberCoordinates)][col].type = "partNumber";
+                    continue;
                 }
-                else
+                //Check the arity of the symbol
+                const std::vector<int> & adjacentSpans = symbolAdjacency[i];
+                int adjacentCount = adjacentSpans.size();
+                if( (query.arityMode == AdjacencyArity::EXACTLY) ? (adjacentCount != query.arity) : (adjacentCount < query.arity) )
                 {
-                    break;
+                    continue;
                 }
-            }
-            //Look to the left of the EnginePosition at numberCoordinates
-            for(int col = (std::get<1>(numberCoordinates)-1); col >= 0; col--)
-            {
-                if(grid[std::get<0>(numberCoordinates)][col].type == "number")
+                //Aggregate the adjacent numbers
+                SymbolQueryMatch match = { row, col, 0, {} };
+                if(query.aggregate == SpanAggregate::LIST)
                 {
-                    partNumber_str = grid[std::get<0>(numberCoordinates)][col].character + partNumber_str;
-                    grid[std::get<0>(numberCoordinates)][col].type = "partNumber";
+                    for(int spanId : adjacentSpans)
+                    {
+                        match.spanValues.push_back(numberSpans[spanId].value);
+                    }
+                    result.total++;
                 }
                 else
                 {
-                    break;
+                    match.value = (query.aggregate == SpanAggregate::PRODUCT) ? 1 : 0;
+                    for(int spanId : adjacentSpans)
+                    {
+                        if(query.aggregate == SpanAggregate::PRODUCT)
+                        {
+                            match.value *= numberSpans[spanId].value;
+                        }
+                        else
+                        {
+                            match.value += numberSpans[spanId].value;
+                        }
+                    }
+                    result.total += match.value;
                 }
+                result.matches.push_back(match);
             }
 
-            //Convert the string representation of our part number into an integer and return it
-            //std::cout << "Found partnumber: " << partNumber_str << std::endl;
-            return std::stoi(partNumber_str);
+            return result;
         }
 
 
-    private:
-
-        /*** Methods ***/
         /**
-         * Given a grid of engine positions that represents the EngineSchematic, iterate through it to find the
-         * the engine positions which have the symbol type.
-         * 
-         * const std::vector< std::vector< EnginePosition > > grid - The 2D vector representing the grid of the engine schematic.
+         * Change the character at a single position of the grid and incrementally update partNumberSum and
+         * gearRatioSum. Only the numbers and symbols around the position are revisited: the numbers in the position's
+         * row that are merged or split by the edit, the numbers in its 3x3 neighborhood, and the symbols adjacent to
+         * any of those numbers. The rest of the grid is never walked.
+         *
+         * Parameters:
+         *  int row - The row of the position we are changing.
+         *  int col - The column of the position we are changing.
+         *  char character - The new character for the position.
         */
-        std::vector< std::tuple<int,int> > findSymbolPositions( const std::vector< std::vector< EnginePosition > > gridParam )
+        void setCell(   int row,
+                        int col,
+                        char character )
         {
-            //Initialize the vector that we'll be returning
-            std::vector< std::tuple<int,int> >foundSymbolPositions = {};
+            if( (row < 0) || (row >= height) || (col < 0) || (col >= width) )
+            {
+                std::cerr << "EngineSchematic Error: setCell(): Position (" << row << "," << col << ") is outside of the grid." << std::endl;
+                return;
+            }
+            if(cells[cellIndex(row, col)] == character)
+            {
+                return;
+            }
+
+            //The numbers in this row touching col-1, col or col+1 may be split, merged, shortened or lengthened, so we
+            //remove them and index their columns again after the edit.
+            int reindexStart = col;
+            int reindexEnd = col;
+            std::vector< std::tuple<int,int> > affectedSymbols = {};
+            for(int c = std::max(col - 1, 0); c <= std::min(col + 1, width - 1); c++)
+            {
+                int spanId = spanIds[cellIndex(row, c)];
+                if(spanId == -1)
+                {
+                    continue;
+                }
+                NumberSpan & span = numberSpans[spanId];
+                reindexStart = std::min(reindexStart, span.colStart);
+                reindexEnd = std::max(reindexEnd, span.colEnd);
+                collectSymbolsAroundSpan(spanId, affectedSymbols);
+                if(span.isPartNumber)
+                {
+                    partNumberSum -= span.value;
+                }
+                for(int spanCol = span.colStart; spanCol <= span.colEnd; spanCol++)
+                {
+                    spanIds[cellIndex(row, spanCol)] = -1;
+                }
+                freeSpanIds.push_back(spanId);
+            }
+
+            //If the old character was a symbol, remove it by moving the last symbol into its slot
+            int oldSymbolId = symbolIds[cellIndex(row, col)];
+            if(oldSymbolId != -1)
+            {
+                gearRatioSum -= gearRatios[oldSymbolId];
+                int lastSymbolId = symbolPositions.size() - 1;
+                symbolPositions.rows[oldSymbolId] = symbolPositions.rows[lastSymbolId];
+                symbolPositions.cols[oldSymbolId] = symbolPositions.cols[lastSymbolId];
+                symbolAdjacency[oldSymbolId].swap(symbolAdjacency[lastSymbolId]);
+                gearRatios[oldSymbolId] = gearRatios[lastSymbolId];
+                symbolIds[cellIndex(symbolPositions.rows[oldSymbolId], symbolPositions.cols[oldSymbolId])] = oldSymbolId;
+                symbolPositions.rows.pop_back();
+                symbolPositions.cols.pop_back();
+                symbolAdjacency.pop_back();
+                gearRatios.pop_back();
+                symbolIds[cellIndex(row, col)] = -1;
+            }
+
+            //Make the edit
+            cells[cellIndex(row, col)] = character;
+            types[cellIndex(row, col)] = POSITIONTYPES[(unsigned char)character];
+            if(isSchematicSymbol(character))
+            {
+                symbolIds[cellIndex(row, col)] = symbolPositions.size();
+                symbolPositions.rows.push_back(row);
+                symbolPositions.cols.push_back(col);
+                symbolAdjacency.push_back( {} );
+                gearRatios.push_back(0);
+                affectedSymbols.push_back( std::make_tuple(row, col) );
+            }
+            std::vector<int> newSpanIds = {};
+            indexNumberSpans(row, reindexStart, reindexEnd, &newSpanIds);
 
-            //Iterate through the rows of the grid
-            for(int row = 0; row < gridParam.size(); row++)
+            //Any new number, and any number around the edited position, may have gained or lost a symbol
+            std::vector<int> affectedSpans = newSpanIds;
+            for(int r = row - 1; r <= row + 1; r += 2)
             {
-                //Iterate through the columns of the grid
-                for(int col = 0; col < gridParam[row].size(); col++)
+                if( (r < 0) || (r >= height) )
                 {
-                    if(gridParam[row][col].type == "symbol")
+                    continue;
+                }
+                for(int c = std::max(col - 1, 0); c <= std::min(col + 1, width - 1); c++)
+                {
+                    int spanId = spanIds[cellIndex(r, c)];
+                    if( (spanId != -1) && (std::find(affectedSpans.begin(), affectedSpans.end(), spanId) == affectedSpans.end()) )
                     {
-                        //std::cout << grid[row][col].character << std::endl;
-                        foundSymbolPositions.push_back( std::make_tuple(row, col) );
+                        affectedSpans.push_back(spanId);
                     }
                 }
             }
+            for(int spanId : affectedSpans)
+            {
+                refreshSpan(spanId);
+            }
 
-            return foundSymbolPositions;
+            //Any symbol that touched a removed number, or touches a new number, may have new adjacent numbers
+            for(int spanId : newSpanIds)
+            {
+                collectSymbolsAroundSpan(spanId, affectedSymbols);
+            }
+            std::vector<int> refreshedSymbolIds = {};
+            for(int i = 0; i < affectedSymbols.size(); i++)
+            {
+                int symbolId = symbolIds[cellIndex(std::get<0>(affectedSymbols[i]), std::get<1>(affectedSymbols[i]))];
+                if( (symbolId != -1) && (std::find(refreshedSymbolIds.begin(), refreshedSymbolIds.end(), symbolId) == refreshedSymbolIds.end()) )
+                {
+                    refreshSymbol(symbolId);
+                    refreshedSymbolIds.push_back(symbolId);
+                }
+            }
         }
-        
-};
 
 
-/**
- * Given an engine schematic object, find the sum of all of the part numbers in the schematic. Part numbers are defined 
- * as any sequence of numbers that are adjacent to a non-period symbol in the schematic's grid.
- * 
- * Parameter:
- *  EngineSchematic engineSchematic - The engineSchematic object we are working with to find the sum of its part numbers.
- *  bool timed - Indicates whether the function is being timed for execution speed or not.
- * 
- * Returns:
- *  void, but prints the sum of all part numbers using std::cout.
-*/
-void findSumOfPartNumbers(EngineSchematic engineSchematic, bool timed )
-{
-    //Begin a running sum of all of the part numbers
-    int runningSum = 0;
-    //Iterate through all of the known symbol positions
-    for(int i = 0; i < engineSchematic.symbolPositions.size(); i++)
-    {
-        //Get all of the adjacent engine positions of type "number" to the symbol
-        std::vector< std::tuple<int,int> > adjacentNumberPositions = engineSchematic.getAdjacentNumbersToPosition(engineSchematic.symbolPositions[i]);
-        
-        //Iterate through all of these number adjacent engine positions
-        for(int k = 0; k < adjacentNumberPositions.size(); k++)
+    private:
+        /*** Member variables ***/
+        std::vector<int> freeSpanIds; //Indices in numberSpans which were removed by setCell and can be reused
+
+        /*** Methods ***/
+        /**
+         * Index every number on the grid into numberSpans, then build the list of adjacent numbers for every symbol in
+         * symbolPositions and the running part number and gear ratio sums. Called once when the schematic is constructed.
+        */
+        void buildSymbolAdjacency()
         {
-            //Before we add compare the part numbers, make sure we haven't already compared them
-            if(engineSchematic.grid[std::get<0>(adjacentNumberPositions[k])][std::get<1>(adjacentNumberPositions[k])].type == "number")
-            {    
-                //Look to the left and right of the number to find the complete number
-                int partNumber = engineSchematic.findCompletePartNumber(adjacentNumberPositions[k]);
+            numberSpans.clear();
+            freeSpanIds.clear();
+            spanIds.assign(cells.size(), -1);
+            symbolIds.assign(cells.size(), -1);
+            symbolAdjacency.assign(symbolPositions.size(), {});
+            gearRatios.assign(symbolPositions.size(), 0);
+            partNumberSum = 0;
+            gearRatioSum = 0;
 
-                //Add the part number to running sum
-                runningSum += partNumber;
+            //Find the spans of all of the numbers on the grid
+            for(int row = 0; row < height; row++)
+            {
+                indexNumberSpans(row, 0, width - 1, nullptr);
+            }
+            for(int i = 0; i < symbolPositions.size(); i++)
+            {
+                symbolIds[cellIndex(symbolPositions.rows[i], symbolPositions.cols[i])] = i;
             }
-        }
-    }
-    //Print the sum of part numbers
-    // if(!timed)
-    // {
-    //     std::cout << "Sum of all part numbers: " << runningSum << std::endl;
-    // }
-}
-
 
-/**
- * Day 3 part 2 of Advent of Code
- * 
-*/
-int findSumOfGearRatios( EngineSchematic engineSchematic )
-{
-    //Find all of the gears. Do this by searching through our symbols and finding the * adjacent to two partNumbers
-    //Initialize the sum of gear ratios
-    int sumOfGearRatios = 0;
-    //Iterate through all of the symbols
-    for(int i = 0; i < engineSchematic.symbolPositions.size(); i++)
-    {
-        EnginePosition currPosition = engineSchematic.grid[std::get<0>(engineSchematic.symbolPositions[i])][std::get<1>(engineSchematic.symbolPositions[i])];
-        //Check to see if the symbol is a *
-        if(currPosition.character == '*')
-        {
-            //If the symbol is *, check to see how many adjacent part numbers there are. If there are 2, then it is a gear.
-            std::vector<int> adjacentPartNumbers = {};
-            //To do this, we'll start with getting all adjacent numbers
-            std::vector< std::tuple<int,int> > adjacentNumberPositions = engineSchematic.getAdjacentNumbersToPosition(engineSchematic.symbolPositions[i]);
-            //Iterate through all of these number adjacent engine positions
-            for(int k = 0; k < adjacentNumberPositions.size(); k++)
-            {
-                //Before we add compare the part numbers, make sure we haven't already compared them
-                if(engineSchematic.grid[std::get<0>(adjacentNumberPositions[k])][std::get<1>(adjacentNumberPositions[k])].type == "number")
-                {    
-                    //Look to the left and right of the number to find the complete number
-                    adjacentPartNumbers.push_back( engineSchematic.findCompletePartNumber(adjacentNumberPositions[k]) );
-                }
+            //Look around each symbol for the distinct numbers that touch it, and each number for a symbol
+            for(int i = 0; i < symbolPositions.size(); i++)
+            {
+                refreshSymbol(i);
             }
-            //If we have exactly two part numbers, multiply them together to find the gear ratio
-            if(adjacentPartNumbers.size() == 2)
+            for(int spanId = 0; spanId < numberSpans.size(); spanId++)
             {
-                sumOfGearRatios += multiplyAllElements(adjacentPartNumbers);
+                refreshSpan(spanId);
             }
-            adjacentPartNumbers.clear();
         }
-    }
-    //Return the sum of gear ratios
-    return sumOfGearRatios;
-}
-
-
-/**
- * Given the input file for day 3 of Advent of Code 2023, return an engine schematic object
- * that we can process for the problem.
- * 
- * Parameter:
- *  std::string inputFileName - The name of the input file.
- * 
- * Returns:
- *  EngineSchematic - The engine schematic object we will use for the problem.
-*/
-EngineSchematic readInput( std::string inputFileName )
-{
-    //Initialize the vector that we will construct the EngineSchematic with
-    std::vector< std::vector< EnginePosition > > grid = {}; 
 
-    //Open the input file
-    std::fstream file;
-    file.open(inputFileName);
-    if(!file.is_open())
-    {
-        std::cout << "There was a problem and we were unable to open a file with the name:'" << inputFileName << "'";
-    }
 
-    //File is ready to go!
-    std::string line;
-    std::vector<EnginePosition> row = {};
-    int rowNum = 0;
-    //Iterate through the file and add each line as a row of the engine schematic
-    while( getline( file, line ) )
-    {
-        for(int p=0; p < line.length(); p++)
+        /**
+         * Index the numbers lying within columns colStart through colEnd of a row into numberSpans. The caller must make
+         * sure no number crosses colStart or colEnd. Freed span indices are reused before numberSpans is grown.
+         *
+         * Parameters:
+         *  int row - The row to index.
+         *  int colStart - The first column to index (inclusive).
+         *  int colEnd - The last column to index (inclusive).
+         *  std::vector<int> * newSpanIds - Optional. The indices of the new spans are appended to this.
+        */
+        void indexNumberSpans(  int row,
+                                int colStart,
+                                int colEnd,
+                                std::vector<int> * newSpanIds )
         {
-            row.push_back(EnginePosition(line[p], rowNum, p));
-        }
-        grid.push_back(row);
-        row.clear();
-        rowNum++;
-    }
-
-    //Close the file
+            int col = colStart;
+            while(col <= colEnd)
+            {
+                if(!isSchematicDigit(cells[cellIndex(row, col)]))
+                {
+                    col++;
+                    continue;
+                }
+                NumberSpan span = { row, col, col, 0 };
+                int spanId = numberSpans.size();
+                if(!freeSpanIds.empty())
+                {
+                    spanId = freeSpanIds.back();
+                    freeSpanIds.pop_back();
+                }
+                while( (col <= colEnd) && isSchematicDigit(cells[cellIndex(row, col)]) )
+                {
+                    span.value = (span.value * 10) + (cells[cellIndex(row, col)] - '0');
+                    spanIds[cellIndex(row, col)] = spanId;
+                    col++;
+                }
+                span.colEnd = col - 1;
+                if(spanId == numberSpans.size())
+                {
+                    numberSpans.push_back(span);
+                }
+                else
+                {
+                    numberSpans[spanId] = span;
+                }
+                if(newSpanIds != nullptr)
+                {
+                    newSpanIds->push_back(spanId);
+                }
+            }
+        }
+
+
+        /**
+         * Recompute whether a number is a part number, keeping partNumberSum up to date.
+        */
+        void refreshSpan( int spanId )
+        {
+            NumberSpan & span = numberSpans[spanId];
+            if(span.isPartNumber)
+            {
+                partNumberSum -= span.value;
+            }
+            span.isPartNumber = false;
+            for(int row = span.row - 1; (row <= span.row + 1) && !span.isPartNumber; row++)
+            {
+                if( (row < 0) || (row >= height) )
+                {
+                    continue;
+                }
+                for(int col = std::max(span.colStart - 1, 0); col <= std::min(span.colEnd + 1, width - 1); col++)
+                {
+                    if(symbolIds[cellIndex(row, col)] != -1)
+                    {
+                        span.isPartNumber = true;
+                        break;
+                    }
+                }
+            }
+            if(span.isPartNumber)
+            {
+                partNumberSum += span.value;
+            }
+        }
+
+
+        /**
+         * Rebuild the list of numbers adjacent to a symbol and recompute its gear ratio, keeping gearRatioSum up to date.
+        */
+        void refreshSymbol( int symbolId )
+        {
+            int symbolRow = symbolPositions.rows[symbolId];
+            int symbolCol = symbolPositions.cols[symbolId];
+            std::vector<int> & adjacentSpans = symbolAdjacency[symbolId];
+            adjacentSpans.clear();
+            for(int row = symbolRow - 1; row <= symbolRow + 1; row++)
+            {
+                if( (row < 0) || (row >= height) )
+                {
+                    continue;
+                }
+                for(int col = symbolCol - 1; col <= symbolCol + 1; col++)
+                {
+                    if( (col < 0) || (col >= width) || (spanIds[cellIndex(row, col)] == -1) )
+                    {
+                        continue;
+                    }
+                    int spanId = spanIds[cellIndex(row, col)];
+                    if(std::find(adjacentSpans.begin(), adjacentSpans.end(), spanId) == adjacentSpans.end())
+                    {
+                        adjacentSpans.push_back(spanId);
+                    }
+                }
+            }
+
+            gearRatioSum -= gearRatios[symbolId];
+            gearRatios[symbolId] = 0;
+            if( (cells[cellIndex(symbolRow, symbolCol)] == '*') && (adjacentSpans.size() == 2) )
+            {
+                gearRatios[symbolId] = numberSpans[adjacentSpans[0]].value * numberSpans[adjacentSpans[1]].value;
+            }
+            gearRatioSum += gearRatios[symbolId];
+        }
+
+
+        /**
+         * Add the coordinates of every symbol adjacent to a number to symbolCoordinates.
+        */
+        void collectSymbolsAroundSpan(  int spanId,
+                                        std::vector< std::tuple<int,int> > & symbolCoordinates )
+        {
+            const NumberSpan & span = numberSpans[spanId];
+            for(int row = span.row - 1; row <= span.row + 1; row++)
+            {
+                if( (row < 0) || (row >= height) )
+                {
+                    continue;
+                }
+                for(int col = std::max(span.colStart - 1, 0); col <= std::min(span.colEnd + 1, width - 1); col++)
+                {
+                    if(symbolIds[cellIndex(row, col)] != -1)
+                    {
+                        symbolCoordinates.push_back( std::make_tuple(row, col) );
+                    }
+                }
+            }
+        }
+
+
+        /**
+         * Produce a bitmask of the symbols among the 32 characters starting at cells[start]: bit i is set if
+         * cells[start + i] is neither a . nor a digit. With AVX2 all 32 characters are classified at once.
+        */
+        unsigned int symbolMask32( size_t start ) const
+        {
+#ifdef __AVX2__
+            __m256i characters = _mm256_loadu_si256( (const __m256i *)(cells.data() + start) );
+            __m256i isDot = _mm256_cmpeq_epi8( characters, _mm256_set1_epi8('.') );
+            //c is a digit when (c - '0') is at most 9 as an unsigned byte
+            __m256i offset = _mm256_sub_epi8( characters, _mm256_set1_epi8('0') );
+            __m256i isDigit = _mm256_cmpeq_epi8( _mm256_min_epu8(offset, _mm256_set1_epi8(9)), offset );
+            return ~(unsigned int)_mm256_movemask_epi8( _mm256_or_si256(isDot, isDigit) );
+#else
+            unsigned int mask = 0;
+            for(int i = 0; i < 32; i++)
+            {
+                if(types[start + i] == PositionType::SYMBOL)
+                {
+                    mask |= (1u << i);
+                }
+            }
+            return mask;
+#endif
+        }
+
+
+        /**
+         * Iterate through the grid of the EngineSchematic to find the positions which have the symbol type.
+         * The grid is classified 32 characters at a time, and the coordinates of the symbols are read from the set bits
+         * of each block's symbol mask. A first pass counts the symbols so the coordinate list is allocated exactly once.
+         * 
+         * Returns:
+         *  SymbolCoordinates - The row and col coordinates of every symbol on the grid.
+        */
+        SymbolCoordinates findSymbolPositions() const
+        {
+            size_t cellCount = cells.size();
+            size_t blockEnd = cellCount - (cellCount % 32);
+
+            //Count the symbols so we can preallocate the coordinate list
+            int symbolCount = 0;
+            for(size_t start = 0; start < blockEnd; start += 32)
+            {
+                symbolCount += __builtin_popcount(symbolMask32(start));
+            }
+            for(size_t i = blockEnd; i < cellCount; i++)
+            {
+                symbolCount += (types[i] == PositionType::SYMBOL);
+            }
+
+            //Initialize the coordinate list that we'll be returning
+            SymbolCoordinates foundSymbolPositions;
+            foundSymbolPositions.rows.resize(symbolCount);
+            foundSymbolPositions.cols.resize(symbolCount);
+
+            //Write the coordinates of each set bit
+            int symbolId = 0;
+            for(size_t start = 0; start < blockEnd; start += 32)
+            {
+                unsigned int mask = symbolMask32(start);
+                while(mask != 0)
+                {
+                    int index = start + __builtin_ctz(mask);
+                    foundSymbolPositions.rows[symbolId] = index / width;
+                    foundSymbolPositions.cols[symbolId] = index % width;
+                    symbolId++;
+                    mask &= (mask - 1);
+                }
+            }
+            for(size_t i = blockEnd; i < cellCount; i++)
+            {
+                if(types[i] == PositionType::SYMBOL)
+                {
+                    foundSymbolPositions.rows[symbolId] = i / width;
+                    foundSymbolPositions.cols[symbolId] = i % width;
+                    symbolId++;
+                }
+            }
+
+            return foundSymbolPositions;
+        }
+        
+};
+
+
+/**
+ * Given an engine schematic object, find the sum of all of the part numbers in the schematic. Part numbers are defined 
+ * as any sequence of numbers that are adjacent to a non-period symbol in the schematic's grid.
+ * 
+ * Parameter:
+ *  const EngineSchematic & engineSchematic - The engineSchematic object we are working with to find the sum of its part numbers.
+ *  bool timed - Indicates whether the function is being timed for execution speed or not.
+ * 
+ * Returns:
+ *  long long int - The sum of all part numbers. Also prints it using std::cout when not timed.
+*/
+long long int findSumOfPartNumbers( const EngineSchematic & engineSchematic,
+                                    bool timed )
+{
+    //Keep track of which numbers we've already added
+    SpanVisitSetPool::Handle visitedSpans = engineSchematic.acquireSpanVisitSet();
+    //Begin a running sum of all of the part numbers
+    long long int runningSum = 0;
+    //Iterate through all of the known symbol positions
+    for(int i = 0; i < engineSchematic.symbolPositions.size(); i++)
+    {
+        //Get all of the adjacent engine positions of type "number" to the symbol
+        std::vector< std::tuple<int,int> > adjacentNumberPositions = engineSchematic.getAdjacentNumbersToPosition( std::make_tuple(engineSchematic.symbolPositions.rows[i], engineSchematic.symbolPositions.cols[i]) );
+        
+        //Iterate through all of these number adjacent engine positions
+        for(int k = 0; k < adjacentNumberPositions.size(); k++)
+        {
+            //Before we add the part number, make sure we haven't already added it
+            if(visitedSpans->visit(engineSchematic.spanIdAt(adjacentNumberPositions[k])))
+            {    
+                //Add the part number to running sum
+                runningSum += engineSchematic.findCompletePartNumber(adjacentNumberPositions[k]);
+            }
+        }
+    }
+    //Print the sum of part numbers
+    if(!timed)
+    {
+        std::cout << "Sum of all part numbers: " << runningSum << std::endl;
+    }
+    return runningSum;
+}
+
+
+/**
+ * Day 3 part 2 of Advent of Code
+ * A gear is any * symbol that is adjacent to exactly two part numbers. Its gear ratio is the product of those
+ * two numbers. Find the sum of all of the gear ratios in the schematic.
+ * 
+ * Parameter:
+ *  const EngineSchematic & engineSchematic - The engine schematic we are finding the gears of.
+ * 
+ * Returns:
+ *  long long int - The sum of all gear ratios.
+*/
+long long int findSumOfGearRatios( const EngineSchematic & engineSchematic )
+{
+    SymbolQuery gearQuery;
+    gearQuery.symbols = "*";
+    gearQuery.arity = 2;
+    gearQuery.arityMode = AdjacencyArity::EXACTLY;
+    gearQuery.aggregate = SpanAggregate::PRODUCT;
+    return engineSchematic.querySymbols(gearQuery).total;
+}
+
+
+/**
+ * The running totals for both parts of the day 3 problem. These are 64-bit so that schematics much larger than
+ * the puzzle input don't overflow them.
+*/
+struct SchematicSums
+{
+    long long int partNumberSum = 0;
+    long long int gearRatioSum = 0;
+};
+
+
+/**
+ * Row accessors for the row evaluators, so the same evaluation code can be used for any row representation.
+*/
+char cellCharacter( const std::string & row, const int col )
+{
+    return row[col];
+}
+
+int rowWidth( const std::string & row )
+{
+    return row.size();
+}
+
+char cellCharacter( const std::string_view row, const int col )
+{
+    return row[col];
+}
+
+int rowWidth( const std::string_view row )
+{
+    return row.size();
+}
+
+
+/**
+ * Given a row and a range of columns, check whether any symbol exists in the row within that range. Columns outside
+ * of the row are ignored, and a null row (above the first row or below the last row) never contains a symbol.
+ *
+ * Parameters:
+ *  const Row * row - The row we are searching, or nullptr if there is no row.
+ *  int colStart - The first column to check (inclusive).
+ *  int colEnd - The last column to check (inclusive).
+ *
+ * Returns:
+ *  bool - True if a symbol is found within the columns, false otherwise.
+*/
+template<typename Row>
+bool rowHasSymbolInColumns( const Row * row,
+                            int colStart,
+                            int colEnd )
+{
+    if(row == nullptr)
+    {
+        return false;
+    }
+    colStart = std::max(colStart, 0);
+    colEnd = std::min(colEnd, rowWidth(*row) - 1);
+    for(int col = colStart; col <= colEnd; col++)
+    {
+        if(isSchematicSymbol(cellCharacter(*row, col)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ * Given the column of a digit within a row, look to the left and right of it to find the whole number it is part of.
+ *
+ * Parameters:
+ *  const Row & row - The row containing the number.
+ *  int col - The column of any digit within the number.
+ *
+ * Returns:
+ *  long long int - The value of the whole number.
+*/
+template<typename Row>
+long long int readNumberAtColumn(   const Row & row,
+                                    int col )
+{
+    //Walk left to the first digit of the number
+    while( (col > 0) && isSchematicDigit(cellCharacter(row, col - 1)) )
+    {
+        col--;
+    }
+    //Then read the digits left to right
+    long long int number = 0;
+    while( (col < rowWidth(row)) && isSchematicDigit(cellCharacter(row, col)) )
+    {
+        number = (number * 10) + (cellCharacter(row, col) - '0');
+        col++;
+    }
+    return number;
+}
+
+
+/**
+ * Given a row that neighbors a symbol, find the numbers in that row which touch the symbol's column (the columns
+ * col-1, col and col+1) and add them to adjacentNumbers. A row holds at most two such numbers: if the digit directly
+ * above/below the symbol is part of a number, that number covers the whole neighborhood.
+ *
+ * Parameters:
+ *  const Row * row - The neighboring row, or nullptr if there is no row.
+ *  int col - The column of the symbol.
+ *  long long int * adjacentNumbers - Where to write the numbers we find. Must have room for 2 more numbers.
+ *  int & adjacentCount - The number of elements already in adjacentNumbers. Incremented for each number found.
+*/
+template<typename Row>
+void collectNumbersTouchingColumn(  const Row * row,
+                                    int col,
+                                    long long int * adjacentNumbers,
+                                    int & adjacentCount )
+{
+    if(row == nullptr)
+    {
+        return;
+    }
+    int width = rowWidth(*row);
+    if( (col < width) && isSchematicDigit(cellCharacter(*row, col)) )
+    {
+        adjacentNumbers[adjacentCount++] = readNumberAtColumn(*row, col);
+        return;
+    }
+    if( (col > 0) && (col - 1 < width) && isSchematicDigit(cellCharacter(*row, col - 1)) )
+    {
+        adjacentNumbers[adjacentCount++] = readNumberAtColumn(*row, col - 1);
+    }
+    if( (col + 1 < width) && isSchematicDigit(cellCharacter(*row, col + 1)) )
+    {
+        adjacentNumbers[adjacentCount++] = readNumberAtColumn(*row, col + 1);
+    }
+}
+
+
+/**
+ * Evaluate a single row of the engine schematic given its neighboring rows. Every number is counted by the row it
+ * lies in, and every gear by the row its * lies in, so evaluating each row of a schematic exactly once counts every
+ * part number and every gear exactly once.
+ *
+ * Parameters:
+ *  const Row * above - The row above the row being evaluated, or nullptr if it's the first row.
+ *  const Row & row - The row being evaluated.
+ *  const Row * below - The row below the row being evaluated, or nullptr if it's the last row.
+ *
+ * Returns:
+ *  SchematicSums - The sum of the part numbers and gear ratios contributed by this row.
+*/
+template<typename Row>
+SchematicSums evaluateRowNeighborhood(  const Row * above,
+                                        const Row & row,
+                                        const Row * below )
+{
+    SchematicSums sums;
+    int width = rowWidth(row);
+    int col = 0;
+    while(col < width)
+    {
+        char c = cellCharacter(row, col);
+        if(isSchematicDigit(c))
+        {
+            //Read the whole number, then check its surroundings for a symbol
+            int spanStart = col;
+            long long int number = 0;
+            while( (col < width) && isSchematicDigit(cellCharacter(row, col)) )
+            {
+                number = (number * 10) + (cellCharacter(row, col) - '0');
+                col++;
+            }
+            if( rowHasSymbolInColumns(above, spanStart - 1, col) ||
+                rowHasSymbolInColumns(&row, spanStart - 1, col) ||
+                rowHasSymbolInColumns(below, spanStart - 1, col) )
+            {
+                sums.partNumberSum += number;
+            }
+            continue;
+        }
+        if(c == '*')
+        {
+            //A * is a gear if exactly two part numbers are adjacent to it
+            long long int adjacentNumbers[6];
+            int adjacentCount = 0;
+            collectNumbersTouchingColumn(above, col, adjacentNumbers, adjacentCount);
+            collectNumbersTouchingColumn(&row, col, adjacentNumbers, adjacentCount);
+            collectNumbersTouchingColumn(below, col, adjacentNumbers, adjacentCount);
+            if(adjacentCount == 2)
+            {
+                sums.gearRatioSum += adjacentNumbers[0] * adjacentNumbers[1];
+            }
+        }
+        col++;
+    }
+    return sums;
+}
+
+
+/**
+ * Stream an engine schematic from an input stream, keeping only a rolling window of three rows in memory. Each row is
+ * evaluated as soon as the row below it has been read, so memory use is proportional to the row width rather than the
+ * size of the schematic. This lets us process schematics that are too large to load with readInput.
+ *
+ * Parameters:
+ *  std::istream & input - The stream we read the schematic from, one row per line.
+ *  const std::function<void(int, const SchematicSums&)> & onRowComplete - Optional. Called with the row number and the
+ *                                                                          running totals each time a row is evaluated.
+ *
+ * Returns:
+ *  SchematicSums - The sum of all part numbers and the sum of all gear ratios in the schematic.
+*/
+SchematicSums streamSchematicSums(  std::istream & input,
+                                    const std::function<void(int, const SchematicSums&)> & onRowComplete = nullptr )
+{
+    SchematicSums totals;
+    //Our three row window. The buffers are swapped rather than copied as the window slides.
+    std::string above, current, below;
+    bool haveAbove = false;
+    bool haveCurrent = false;
+    int rowNum = 0;
+
+    while( getline( input, below ) )
+    {
+        //Handle CRLF line endings and skip blank lines, the same way readInput does
+        if( !below.empty() && (below.back() == '\r') )
+        {
+            below.pop_back();
+        }
+        if(below.empty())
+        {
+            continue;
+        }
+        //The row below has arrived, so the current row's neighborhood is complete
+        if(haveCurrent)
+        {
+            SchematicSums rowSums = evaluateRowNeighborhood(haveAbove ? &above : nullptr, current, &below);
+            totals.partNumberSum += rowSums.partNumberSum;
+            totals.gearRatioSum += rowSums.gearRatioSum;
+            if(onRowComplete)
+            {
+                onRowComplete(rowNum - 1, totals);
+            }
+        }
+        //Slide the window down a row
+        above.swap(current);
+        current.swap(below);
+        haveAbove = haveCurrent;
+        haveCurrent = true;
+        rowNum++;
+    }
+    //The last row has no row below it
+    if(haveCurrent)
+    {
+        SchematicSums rowSums = evaluateRowNeighborhood(haveAbove ? &above : nullptr, current, static_cast<const std::string *>(nullptr));
+        totals.partNumberSum += rowSums.partNumberSum;
+        totals.gearRatioSum += rowSums.gearRatioSum;
+        if(onRowComplete)
+        {
+            onRowComplete(rowNum - 1, totals);
+        }
+    }
+
+    return totals;
+}
+
+
+/**
+ * Evaluate an engine schematic in parallel by splitting its grid into horizontal bands, one per thread. Each thread
+ * evaluates the rows of its own band, reading the row just above and just below the band as a one-row halo. Since a
+ * number or gear is only ever counted by the row it lies in, numbers and gears whose neighborhoods straddle a band
+ * boundary are still counted exactly once. The per-band partial sums are reduced into 64-bit totals.
+ *
+ * Parameters:
+ *  const EngineSchematic & engineSchematic - The engine schematic we are evaluating. It is only read from.
+ *  int threadCount - The number of bands/threads to split the grid into.
+ *
+ * Returns:
+ *  SchematicSums - The sum of all part numbers and the sum of all gear ratios in the schematic.
+*/
+SchematicSums evaluateSchematicInBands( const EngineSchematic & engineSchematic,
+                                        int threadCount )
+{
+    int rowCount = engineSchematic.height;
+    threadCount = std::max(1, std::min(threadCount, rowCount));
+    int rowsPerBand = (rowCount + threadCount - 1) / threadCount;
+
+    //Each band writes only to its own partial sum, so the threads don't need to synchronize
+    std::vector<SchematicSums> bandSums(threadCount);
+    std::vector<std::thread> threads = {};
+    for(int band = 0; band < threadCount; band++)
+    {
+        threads.emplace_back( [&engineSchematic, &bandSums, band, rowsPerBand, rowCount]()
+        {
+            int bandStart = band * rowsPerBand;
+            int bandEnd = std::min(bandStart + rowsPerBand, rowCount);
+            //Sum locally so neighboring bands aren't writing to the same cache line on every row
+            SchematicSums localSums;
+            for(int row = bandStart; row < bandEnd; row++)
+            {
+                //The rows above and below may belong to a neighboring band. We only read them.
+                std::string_view current = engineSchematic.rowView(row);
+                std::string_view above = (row > 0) ? engineSchematic.rowView(row - 1) : std::string_view();
+                std::string_view below = (row + 1 < rowCount) ? engineSchematic.rowView(row + 1) : std::string_view();
+                SchematicSums rowSums = evaluateRowNeighborhood( (row > 0) ? &above : nullptr,
+                                                                 current,
+                                                                 (row + 1 < rowCount) ? &below : nullptr );
+                localSums.partNumberSum += rowSums.partNumberSum;
+                localSums.gearRatioSum += rowSums.gearRatioSum;
+            }
+            bandSums[band] = localSums;
+        });
+    }
+
+    //Wait for all of the bands, then reduce their partial sums
+    SchematicSums totals;
+    for(int band = 0; band < threadCount; band++)
+    {
+        threads[band].join();
+        totals.partNumberSum += bandSums[band].partNumberSum;
+        totals.gearRatioSum += bandSums[band].gearRatioSum;
+    }
+    return totals;
+}
+
+
+/**
+ * Given the input file for day 3 of Advent of Code 2023, return an engine schematic object
+ * that we can process for the problem.
+ * 
+ * The whole file is read in one block, and the line breaks are squeezed out of that same buffer so it becomes the
+ * schematic's flat grid without any further copies. Every row must have the same width.
+ * 
+ * Parameter:
+ *  std::string inputFileName - The name of the input file.
+ * 
+ * Returns:
+ *  EngineSchematic - The engine schematic object we will use for the problem.
+*/
+EngineSchematic readInput( std::string inputFileName )
+{
+    //Open the input file
+    std::ifstream file(inputFileName, std::ios::binary | std::ios::ate);
+    if(!file.is_open())
+    {
+        std::cout << "There was a problem and we were unable to open a file with the name:'" << inputFileName << "'" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    //File is ready to go! Read the whole thing in one block.
+    std::string cells(file.tellg(), '\0');
+    file.seekg(0);
+    file.read(cells.data(), cells.size());
     file.close();
 
+    //Walk the rows, moving each one down over the line breaks before it
+    int width = -1;
+    int height = 0;
+    size_t readPos = 0;
+    size_t writePos = 0;
+    while(readPos < cells.size())
+    {
+        size_t lineEnd = cells.find('\n', readPos);
+        if(lineEnd == std::string::npos)
+        {
+            lineEnd = cells.size();
+        }
+        size_t nextLine = lineEnd + 1;
+        //Handle CRLF line endings
+        if( (lineEnd > readPos) && (cells[lineEnd - 1] == '\r') )
+        {
+            lineEnd--;
+        }
+        int lineWidth = lineEnd - readPos;
+        //Skip blank lines, such as a trailing one at the end of the file
+        if(lineWidth > 0)
+        {
+            if(width == -1)
+            {
+                width = lineWidth;
+            }
+            else if(lineWidth != width)
+            {
+                std::cout << "Row " << height << " of '" << inputFileName << "' has width " << lineWidth << " but the rows before it have width " << width << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            if(writePos != readPos)
+            {
+                std::copy(cells.begin() + readPos, cells.begin() + lineEnd, cells.begin() + writePos);
+            }
+            writePos += lineWidth;
+            height++;
+        }
+        readPos = nextLine;
+    }
+    cells.resize(writePos);
+
     //Construct the EngineSchematic and return it
-    EngineSchematic engineSchematic = EngineSchematic(grid);
-    return engineSchematic;
+    return EngineSchematic(std::move(cells), std::max(width, 0), height);
+}
+
+
+/**
+ * On-disk layout of a tiled engine schematic. The file is a TiledSchematicHeader, then a TiledSchematicTileEntry
+ * for every tile in row-major tile order, then the data of each tile starting on a 4096 byte boundary. A tile's data
+ * is its characters (row-major, tile width by tile height; smaller for the tiles on the right and bottom edges),
+ * then its TiledSchematicSymbols, then its TiledSchematicSpans, each list starting on an 8 byte boundary.
+ *
+ * Every number belongs to the tile holding its first digit, and every symbol to the tile holding it. Whether a number
+ * is a part number and what a symbol's gear ratio is are worked out when the file is written, so a region can be
+ * summed from the tiles it overlaps alone. Values are stored in the byte order of the machine that wrote the file.
+*/
+const char TILEDSCHEMATICMAGIC[8] = { 'A', 'o', 'C', '3', 'T', 'I', 'L', 'E' };
+const int TILEDSCHEMATICALIGNMENT = 4096;
+
+struct TiledSchematicHeader
+{
+    char magic[8];
+    int32_t width;
+    int32_t height;
+    int32_t tileSize;
+    int32_t tileRows;
+    int32_t tileCols;
+    int32_t reserved;
+};
+
+struct TiledSchematicTileEntry
+{
+    uint64_t offset; //Where the tile's data starts in the file
+    uint64_t length; //The length of the tile's data
+    uint32_t symbolCount;
+    uint32_t spanCount;
+    int64_t partNumberSum; //The sum of the part numbers belonging to the tile
+    int64_t gearRatioSum; //The sum of the gear ratios of the gears belonging to the tile
+};
+
+struct TiledSchematicSymbol
+{
+    int32_t row; //Relative to the tile
+    int32_t col; //Relative to the tile
+    int64_t gearRatio; //0 if the symbol is not a gear
+};
+
+struct TiledSchematicSpan
+{
+    int32_t row; //Relative to the tile
+    int32_t colStart; //Relative to the tile. The number may continue past the right edge of the tile.
+    int32_t length;
+    int32_t isPartNumber;
+    int64_t value;
+};
+
+
+/**
+ * Round offset up to the next multiple of alignment.
+*/
+uint64_t alignOffset(   uint64_t offset,
+                        uint64_t alignment )
+{
+    return ((offset + alignment - 1) / alignment) * alignment;
+}
+
+
+/**
+ * Write an engine schematic to a file in the tiled format described above TiledSchematicHeader.
+ *
+ * Parameters:
+ *  const EngineSchematic & engineSchematic - The schematic to write.
+ *  std::string outputFileName - The name of the file to write.
+ *  int tileSize - The width and height of each tile.
+*/
+void writeTiledSchematic(   const EngineSchematic & engineSchematic,
+                            std::string outputFileName,
+                            int tileSize = 256 )
+{
+    if(tileSize <= 0)
+    {
+        std::cout << "The tile size must be at least 1, but was " << tileSize << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    TiledSchematicHeader header = {};
+    std::memcpy(header.magic, TILEDSCHEMATICMAGIC, sizeof(header.magic));
+    header.width = engineSchematic.width;
+    header.height = engineSchematic.height;
+    header.tileSize = tileSize;
+    header.tileRows = (engineSchematic.height + tileSize - 1) / tileSize;
+    header.tileCols = (engineSchematic.width + tileSize - 1) / tileSize;
+    int tileCount = header.tileRows * header.tileCols;
+
+    //Sort the symbols and numbers into the tiles they belong to
+    std::vector< std::vector<TiledSchematicSymbol> > tileSymbols(tileCount);
+    std::vector< std::vector<TiledSchematicSpan> > tileSpans(tileCount);
+    std::vector<TiledSchematicTileEntry> entries(tileCount);
+    for(int i = 0; i < engineSchematic.symbolPositions.size(); i++)
+    {
+        int row = engineSchematic.symbolPositions.rows[i];
+        int col = engineSchematic.symbolPositions.cols[i];
+        int tile = ((row / tileSize) * header.tileCols) + (col / tileSize);
+        tileSymbols[tile].push_back( { row % tileSize, col % tileSize, engineSchematic.gearRatios[i] } );
+        entries[tile].gearRatioSum += engineSchematic.gearRatios[i];
+    }
+    //Every digit of a number maps to it, so we find the numbers through their first digits
+    for(int index = 0; index < engineSchematic.spanIds.size(); index++)
+    {
+        int spanId = engineSchematic.spanIds[index];
+        int row = index / engineSchematic.width;
+        int col = index % engineSchematic.width;
+        if( (spanId == -1) || (engineSchematic.numberSpans[spanId].colStart != col) )
+        {
+            continue;
+        }
+        const NumberSpan & span = engineSchematic.numberSpans[spanId];
+        int tile = ((row / tileSize) * header.tileCols) + (col / tileSize);
+        tileSpans[tile].push_back( { row % tileSize, col % tileSize, span.colEnd - span.colStart + 1, span.isPartNumber, span.value } );
+        if(span.isPartNumber)
+        {
+            entries[tile].partNumberSum += span.value;
+        }
+    }
+
+    //Lay the tiles out in the file
+    uint64_t offset = alignOffset(sizeof(TiledSchematicHeader) + (tileCount * sizeof(TiledSchematicTileEntry)), TILEDSCHEMATICALIGNMENT);
+    for(int tile = 0; tile < tileCount; tile++)
+    {
+        int tileHeight = std::min(tileSize, engineSchematic.height - ((tile / header.tileCols) * tileSize));
+        int tileWidth = std::min(tileSize, engineSchematic.width - ((tile % header.tileCols) * tileSize));
+        uint64_t length = alignOffset((uint64_t)tileWidth * tileHeight, 8);
+        length += tileSymbols[tile].size() * sizeof(TiledSchematicSymbol);
+        length += tileSpans[tile].size() * sizeof(TiledSchematicSpan);
+        entries[tile].offset = offset;
+        entries[tile].length = length;
+        entries[tile].symbolCount = tileSymbols[tile].size();
+        entries[tile].spanCount = tileSpans[tile].size();
+        offset = alignOffset(offset + length, TILEDSCHEMATICALIGNMENT);
+    }
+
+    //Write the file
+    std::ofstream file(outputFileName, std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+    {
+        std::cout << "There was a problem and we were unable to open a file with the name:'" << outputFileName << "'" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    file.write((const char *)&header, sizeof(header));
+    file.write((const char *)entries.data(), tileCount * sizeof(TiledSchematicTileEntry));
+    const char padding[TILEDSCHEMATICALIGNMENT] = {};
+    for(int tile = 0; tile < tileCount; tile++)
+    {
+        file.write(padding, entries[tile].offset - (uint64_t)file.tellp());
+        int tileRow = tile / header.tileCols;
+        int tileCol = tile % header.tileCols;
+        int tileHeight = std::min(tileSize, engineSchematic.height - (tileRow * tileSize));
+        int tileWidth = std::min(tileSize, engineSchematic.width - (tileCol * tileSize));
+        for(int row = 0; row < tileHeight; row++)
+        {
+            file.write(engineSchematic.cells.data() + engineSchematic.cellIndex((tileRow * tileSize) + row, tileCol * tileSize), tileWidth);
+        }
+        file.write(padding, alignOffset((uint64_t)tileWidth * tileHeight, 8) - ((uint64_t)tileWidth * tileHeight));
+        file.write((const char *)tileSymbols[tile].data(), tileSymbols[tile].size() * sizeof(TiledSchematicSymbol));
+        file.write((const char *)tileSpans[tile].data(), tileSpans[tile].size() * sizeof(TiledSchematicSpan));
+    }
+    file.close();
 }
 
 
+/**
+ * Read access to an engine schematic written by writeTiledSchematic. Only the header and tile directory are loaded
+ * up front; the data of a tile is memory-mapped only when a query needs it.
+*/
+class TiledSchematic
+{
+    public:
+        /*** Member variables ***/
+        TiledSchematicHeader header;
+        std::vector<TiledSchematicTileEntry> entries;
+
+        /*** Constructors ***/
+        //Parametric
+        TiledSchematic( std::string inputFileName )
+        {
+            fileDescriptor = open(inputFileName.c_str(), O_RDONLY);
+            if(fileDescriptor == -1)
+            {
+                std::cout << "There was a problem and we were unable to open a file with the name:'" << inputFileName << "'" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            if( (pread(fileDescriptor, &header, sizeof(header), 0) != sizeof(header)) ||
+                (std::memcmp(header.magic, TILEDSCHEMATICMAGIC, sizeof(header.magic)) != 0) )
+            {
+                std::cout << "'" << inputFileName << "' is not a tiled engine schematic file" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            if(header.tileSize <= 0)
+            {
+                std::cout << "'" << inputFileName << "' has an invalid tile size of " << header.tileSize << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            entries.resize(header.tileRows * header.tileCols);
+            size_t directoryLength = entries.size() * sizeof(TiledSchematicTileEntry);
+            if(pread(fileDescriptor, entries.data(), directoryLength, sizeof(header)) != (ssize_t)directoryLength)
+            {
+                std::cout << "The tile directory of '" << inputFileName << "' is incomplete" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        TiledSchematic( const TiledSchematic & ) = delete;
+        TiledSchematic & operator=( const TiledSchematic & ) = delete;
+
+        ~TiledSchematic()
+        {
+            close(fileDescriptor);
+        }
+
+
+        /*** Methods ***/
+        /**
+         * Find the sums of the part numbers and gear ratios within a rectangular region of the schematic. A number is in
+         * the region if its first digit is, and a gear is in the region if its * is. Tiles entirely inside the region
+         * are summed from the tile directory, tiles on the edge of the region are memory-mapped and their symbol and
+         * number lists filtered, and all other tiles are never touched.
+         *
+         * Parameters:
+         *  int rowStart - The first row of the region (inclusive).
+         *  int colStart - The first column of the region (inclusive).
+         *  int rowEnd - The last row of the region (inclusive).
+         *  int colEnd - The last column of the region (inclusive).
+         *
+         * Returns:
+         *  SchematicSums - The sum of the part numbers and gear ratios within the region.
+        */
+        SchematicSums regionSums(   int rowStart,
+                                    int colStart,
+                                    int rowEnd,
+                                    int colEnd ) const
+        {
+            SchematicSums sums;
+            rowStart = std::max(rowStart, 0);
+            colStart = std::max(colStart, 0);
+            rowEnd = std::min(rowEnd, header.height - 1);
+            colEnd = std::min(colEnd, header.width - 1);
+            if( (rowStart > rowEnd) || (colStart > colEnd) )
+            {
+                return sums;
+            }
+
+            for(int tileRow = rowStart / header.tileSize; tileRow <= rowEnd / header.tileSize; tileRow++)
+            {
+                for(int tileCol = colStart / header.tileSize; tileCol <= colEnd / header.tileSize; tileCol++)
+                {
+                    const TiledSchematicTileEntry & entry = entries[(tileRow * header.tileCols) + tileCol];
+                    int tileTop = tileRow * header.tileSize;
+                    int tileLeft = tileCol * header.tileSize;
+                    //Tiles on the bottom and right edges of the schematic can be smaller than the tile size
+                    int tileHeight = std::min(header.tileSize, header.height - tileTop);
+                    int tileWidth = std::min(header.tileSize, header.width - tileLeft);
+                    //A tile entirely inside of the region only needs its directory totals
+                    if( (tileTop >= rowStart) && (tileTop + tileHeight - 1 <= rowEnd) &&
+                        (tileLeft >= colStart) && (tileLeft + tileWidth - 1 <= colEnd) )
+                    {
+                        sums.partNumberSum += entry.partNumberSum;
+                        sums.gearRatioSum += entry.gearRatioSum;
+                        continue;
+                    }
+                    //Otherwise, map the tile and check each of its symbols and numbers
+                    long pageSize = sysconf(_SC_PAGESIZE);
+                    uint64_t mapOffset = (entry.offset / pageSize) * pageSize;
+                    size_t mapLength = (entry.offset - mapOffset) + entry.length;
+                    if(mapLength == 0)
+                    {
+                        continue;
+                    }
+                    void * mapping = mmap(nullptr, mapLength, PROT_READ, MAP_PRIVATE, fileDescriptor, mapOffset);
+                    if(mapping == MAP_FAILED)
+                    {
+                        std::cerr << "TiledSchematic Error: regionSums(): Unable to map tile (" << tileRow << "," << tileCol << ")" << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                    const char * tileData = (const char *)mapping + (entry.offset - mapOffset);
+                    const TiledSchematicSymbol * symbols = (const TiledSchematicSymbol *)(tileData + alignOffset((uint64_t)tileWidth * tileHeight, 8));
+                    const TiledSchematicSpan * spans = (const TiledSchematicSpan *)(symbols + entry.symbolCount);
+                    for(uint32_t i = 0; i < entry.symbolCount; i++)
+                    {
+                        if(inRegion(tileTop + symbols[i].row, tileLeft + symbols[i].col, rowStart, colStart, rowEnd, colEnd))
+                        {
+                            sums.gearRatioSum += symbols[i].gearRatio;
+                        }
+                    }
+                    for(uint32_t i = 0; i < entry.spanCount; i++)
+                    {
+                        if( spans[i].isPartNumber && inRegion(tileTop + spans[i].row, tileLeft + spans[i].colStart, rowStart, colStart, rowEnd, colEnd) )
+                        {
+                            sums.partNumberSum += spans[i].value;
+                        }
+                    }
+                    munmap(mapping, mapLength);
+                }
+            }
+            return sums;
+        }
+
+
+    private:
+        /*** Member variables ***/
+        int fileDescriptor;
+
+        /*** Methods ***/
+        static bool inRegion(   int row,
+                                int col,
+                                int rowStart,
+                                int colStart,
+                                int rowEnd,
+                                int colEnd )
+        {
+            return (row >= rowStart) && (row <= rowEnd) && (col >= colStart) && (col <= colEnd);
+        }
+};
+
+
 int main(   int argc, char * argv[]   )
 {
     InputParser inputParser =  InputParser(argc, argv);
@@ -509,9 +1741,144 @@ int main(   int argc, char * argv[]   )
         return 1;
     }
 
+    //Sum a region of a tiled schematic file written with -w: -r <ROWSTART,COLSTART,ROWEND,COLEND>
+    if(inputParser.cmdOptionExists("-r"))
+    {
+        int region[4] = { 0, 0, 0, 0 };
+        std::stringstream regionStream(inputParser.getCmdOption("-r"));
+        std::string bound;
+        for(int i = 0; (i < 4) && getline(regionStream, bound, ','); i++)
+        {
+            region[i] = std::stoi(bound);
+        }
+        TiledSchematic tiledSchematic(inputFileName);
+        SchematicSums sums = tiledSchematic.regionSums(region[0], region[1], region[2], region[3]);
+        if(partToExecute == "1")
+        {
+            std::cout << "Sum of part numbers in region: " << sums.partNumberSum << std::endl;
+        }
+        if(partToExecute == "2")
+        {
+            std::cout << "Sum of gear ratios in region: " << sums.gearRatioSum << std::endl;
+        }
+        return 0;
+    }
+
+    //Stream the file instead of loading it, for schematics too large to fit in memory. Use -f - to read from stdin.
+    if(inputParser.cmdOptionExists("-s"))
+    {
+        std::ifstream file;
+        if(inputFileName != "-")
+        {
+            file.open(inputFileName);
+            if(!file.is_open())
+            {
+                std::cout << "There was a problem and we were unable to open a file with the name:'" << inputFileName << "'" << std::endl;
+                return 1;
+            }
+        }
+        SchematicSums sums = streamSchematicSums( (inputFileName == "-") ? std::cin : file );
+        if(partToExecute == "1")
+        {
+            std::cout << "Sum of all part numbers: " << sums.partNumberSum << std::endl;
+        }
+        if(partToExecute == "2")
+        {
+            std::cout << "Sum of gear ratios: " << sums.gearRatioSum << std::endl;
+        }
+        return 0;
+    }
+
     //Read in the file
     EngineSchematic engineSchematic = readInput( inputFileName );
 
+    //Write the schematic out as a tiled schematic file: -w <OUTPUT FILENAME> [-z <TILE SIZE>]
+    if(inputParser.cmdOptionExists("-w"))
+    {
+        int tileSize = inputParser.cmdOptionExists("-z") ? std::stoi(inputParser.getCmdOption("-z")) : 256;
+        writeTiledSchematic(engineSchematic, inputParser.getCmdOption("-w"), tileSize);
+        std::cout << "Wrote tiled schematic to '" << inputParser.getCmdOption("-w") << "'" << std::endl;
+        return 0;
+    }
+
+    //Run a custom symbol query: -q <SYMBOLS> [-k <ARITY>] [-m exactly|atleast] [-a sum|product|list]
+    if(inputParser.cmdOptionExists("-q"))
+    {
+        SymbolQuery query;
+        query.symbols = inputParser.getCmdOption("-q");
+        if(inputParser.cmdOptionExists("-k"))
+        {
+            query.arity = std::stoi(inputParser.getCmdOption("-k"));
+        }
+        if(inputParser.getCmdOption("-m") == "atleast")
+        {
+            query.arityMode = AdjacencyArity::AT_LEAST;
+        }
+        std::string aggregate = inputParser.getCmdOption("-a");
+        if(aggregate == "sum")
+        {
+            query.aggregate = SpanAggregate::SUM;
+        }
+        else if(aggregate == "list")
+        {
+            query.aggregate = SpanAggregate::LIST;
+        }
+
+        SymbolQueryResult result = engineSchematic.querySymbols(query);
+        if(query.aggregate == SpanAggregate::LIST)
+        {
+            for(int i = 0; i < result.matches.size(); i++)
+            {
+                std::cout << "(" << result.matches[i].row << "," << result.matches[i].col << "):";
+                for(int k = 0; k < result.matches[i].spanValues.size(); k++)
+                {
+                    std::cout << " " << result.matches[i].spanValues[k];
+                }
+                std::cout << std::endl;
+            }
+            std::cout << "Matching symbols: " << result.total << std::endl;
+        }
+        else
+        {
+            std::cout << "Query total: " << result.total << std::endl;
+        }
+        return 0;
+    }
+
+    //Evaluate the schematic in parallel row bands. -j <THREADS>, where 0 uses every available core.
+    if(inputParser.cmdOptionExists("-j"))
+    {
+        int threadCount = std::stoi(inputParser.getCmdOption("-j"));
+        if(threadCount <= 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if(inputParser.cmdOptionExists("-t"))
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            for(int i = 0; i < 1000; i++)
+            {
+                evaluateSchematicInBands(engineSchematic, threadCount);
+            }
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+            std::cout << "The average exeuction time of AoC day 3, parts 1 and 2 with " << threadCount << " threads (microseconds): " << ((duration.count() /1000)) << std::endl;
+        }
+        else
+        {
+            SchematicSums sums = evaluateSchematicInBands(engineSchematic, threadCount);
+            if(partToExecute == "1")
+            {
+                std::cout << "Sum of all part numbers: " << sums.partNumberSum << std::endl;
+            }
+            if(partToExecute == "2")
+            {
+                std::cout << "Sum of gear ratios: " << sums.gearRatioSum << std::endl;
+            }
+        }
+        return 0;
+    }
+
     if(partToExecute == "1")
     {
         //Find the average time of the execution
@@ -549,7 +1916,7 @@ int main(   int argc, char * argv[]   )
         //Execute normally
         else
         {
-            int answer = findSumOfGearRatios( engineSchematic );
+            long long int answer = findSumOfGearRatios( engineSchematic );
             std::cout << "Sum of gear ratios: " << answer << std::endl;
         }
     }
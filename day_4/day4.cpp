@@ -6,68 +6,355 @@
 #include<fstream>
 #include<string>
 #include<vector>
-#include<cmath>
 #include<chrono>
-#include<unordered_map>
+#include<string_view>
+#include<array>
+#include<bit>
+#include<cstdint>
+#include<climits>
+#include<thread>
+#include<functional>
+#include<memory>
+#include<span>
+#ifdef __AVX2__
+#include<immintrin.h>
+#endif
 #include "InputParser.h"
-#include "stevensStringLib.h"
 
 
 /**
- * Predicate for eraseNonNumericChars. Determines if a character is non-numeric (true) or numeric (false)
+ * A vector which stores up to N elements inline, only moving its elements to the heap once it grows past N.
+ * Used for the short number lists on a scratchcard so that most cards need no heap allocations.
 */
-bool isNonNumeric( char c )
+template<typename T, int N>
+class SmallVector
 {
-    std::unordered_map<char,bool> numericCharacters = { {'0',   0},
-                                                        {'1',   0},
-                                                        {'2',   0},
-                                                        {'3',   0},
-                                                        {'4',   0},
-                                                        {'5',   0},
-                                                        {'6',   0},
-                                                        {'7',   0},
-                                                        {'8',   0},
-                                                        {'9',   0}  };
-    
-    if(numericCharacters.contains(c))
+    public:
+        void push_back( const T & item )
+        {
+            if(!spilled && (count < N))
+            {
+                inlineItems[count] = item;
+            }
+            else
+            {
+                //Spill everything over to the heap the first time we run out of inline room
+                if(!spilled)
+                {
+                    heapItems.assign(inlineItems.begin(), inlineItems.end());
+                    spilled = true;
+                }
+                heapItems.push_back(item);
+            }
+            count++;
+        }
+
+        //Drop the elements past newSize
+        void truncate( int newSize )
+        {
+            count = std::min(count, newSize);
+            if(spilled)
+            {
+                heapItems.resize(count);
+            }
+        }
+
+        void clear()
+        {
+            count = 0;
+            spilled = false;
+            heapItems.clear();
+        }
+
+        int size() const { return count; }
+        bool empty() const { return count == 0; }
+        T * data() { return spilled ? heapItems.data() : inlineItems.data(); }
+        const T * data() const { return spilled ? heapItems.data() : inlineItems.data(); }
+        T * begin() { return data(); }
+        T * end() { return data() + count; }
+        const T * begin() const { return data(); }
+        const T * end() const { return data() + count; }
+        T & operator[]( int i ) { return data()[i]; }
+        const T & operator[]( int i ) const { return data()[i]; }
+
+    private:
+        std::array<T, N> inlineItems = {};
+        std::vector<T> heapItems = {};
+        int count = 0;
+        bool spilled = false;
+};
+
+
+/**
+ * A set of the numbers 0 through 127, stored as a 128-bit mask. Counting the numbers two sets share takes an AND and
+ * a popcount for each half of the mask.
+*/
+struct NumberMask128
+{
+    uint64_t words[2] = { 0, 0 };
+
+    //Whether a number can be stored in the mask
+    static bool fits( int number )
     {
-        return false;
+        return (number >= 0) && (number < 128);
+    }
+
+    //Add a number to the set. Returns false if the number was already in it.
+    bool add( int number )
+    {
+        uint64_t bit = 1ull << (number % 64);
+        bool added = (words[number / 64] & bit) == 0;
+        words[number / 64] |= bit;
+        return added;
+    }
+
+    //The number of numbers in both this set and other
+    int countCommon( const NumberMask128 & other ) const
+    {
+        return std::popcount(words[0] & other.words[0]) + std::popcount(words[1] & other.words[1]);
+    }
+};
+
+
+/**
+ * Count how many of the candidate numbers appear among the winning numbers, for numbers packed as 16-bit lanes.
+ * Each winning number is broadcast to every lane and compared against 16 candidates at a time, and the matching
+ * lanes are counted with a popcount of the compare mask. The winning numbers must not repeat.
+ * 
+ * Parameters:
+ *  const uint16_t * winningNumbers - The winning numbers.
+ *  int winningCount - The number of winning numbers.
+ *  const uint16_t * candidateNumbers - The candidate numbers.
+ *  int candidateCount - The number of candidate numbers.
+ * 
+ * Returns:
+ *  int - The number of candidate numbers that are winning numbers.
+*/
+int countMatchesLanes16(    const uint16_t * winningNumbers,
+                            int winningCount,
+                            const uint16_t * candidateNumbers,
+                            int candidateCount )
+{
+    int matches = 0;
+    int c = 0;
+#ifdef __AVX2__
+    for(; c + 16 <= candidateCount; c += 16)
+    {
+        __m256i candidates = _mm256_loadu_si256( (const __m256i *)(candidateNumbers + c) );
+        for(int w = 0; w < winningCount; w++)
+        {
+            __m256i equal = _mm256_cmpeq_epi16( candidates, _mm256_set1_epi16((short)winningNumbers[w]) );
+            //Each 16-bit lane sets two bits of the byte mask
+            matches += std::popcount((unsigned int)_mm256_movemask_epi8(equal)) / 2;
+        }
     }
-    else
+#endif
+    //Whatever doesn't fill a whole vector is compared one at a time
+    for(; c < candidateCount; c++)
     {
-        return true;
+        for(int w = 0; w < winningCount; w++)
+        {
+            matches += (candidateNumbers[c] == winningNumbers[w]);
+        }
     }
+    return matches;
 }
 
 
 /**
- * Erases all non-numeric characters from a string and returns it.
+ * Count how many of the candidate numbers appear among the winning numbers, for numbers that don't fit in a
+ * NumberMask128. If every number fits in 16 bits they are packed into lanes for countMatchesLanes16, and otherwise
+ * each candidate is binary searched. The winning numbers must be sorted and must not repeat.
  * 
- * Parameter:
- *  std::string str - The string to release all non-numeric chars from.
+ * Parameters:
+ *  const int * winningNumbers - The winning numbers.
+ *  int winningCount - The number of winning numbers.
+ *  const int * candidateNumbers - The candidate numbers.
+ *  int candidateCount - The number of candidate numbers.
  * 
  * Returns:
- *  The string parameter we passed in, but all of its non-numeric characters removed from it.
+ *  int - The number of candidate numbers that are winning numbers.
 */
-std::string eraseNonNumericChars(   std::string str )
+int countMatchesSorted( const int * winningNumbers,
+                        int winningCount,
+                        const int * candidateNumbers,
+                        int candidateCount )
 {
-    //std::cout << "str befor eraseNonNumericChars:" << str << std::endl;
-    str.erase(std::remove_if(str.begin(), str.end(), isNonNumeric), str.end());
-    //std::cout << "str after eraseNonNumericChars: " << str << std::endl; 
-    return str;
+    //Pack the numbers into 16-bit lanes for the compare kernel if they all fit
+    SmallVector<uint16_t, 16> winningLanes;
+    SmallVector<uint16_t, 32> candidateLanes;
+    bool fitsInLanes = true;
+    for(int i = 0; (i < winningCount) && fitsInLanes; i++)
+    {
+        fitsInLanes = (winningNumbers[i] >= 0) && (winningNumbers[i] <= UINT16_MAX);
+        winningLanes.push_back(winningNumbers[i]);
+    }
+    for(int i = 0; (i < candidateCount) && fitsInLanes; i++)
+    {
+        fitsInLanes = (candidateNumbers[i] >= 0) && (candidateNumbers[i] <= UINT16_MAX);
+        candidateLanes.push_back(candidateNumbers[i]);
+    }
+    if(fitsInLanes)
+    {
+        return countMatchesLanes16(winningLanes.data(), winningLanes.size(), candidateLanes.data(), candidateLanes.size());
+    }
+
+    int matches = 0;
+    //Iterate through all of the candidate numbers
+    for(int i = 0; i < candidateCount; i++)
+    {
+        //Check to see if the candidate number is a winning number
+        if(std::binary_search(winningNumbers, winningNumbers + winningCount, candidateNumbers[i]))
+        {
+            matches++;
+        }
+    }
+    return matches;
+}
+
+
+/**
+ * The score of a card with the given number of matches: nothing for no matches, one point for the first match, and
+ * double for every match after that. Scores of more than 64 matches don't fit in 64 bits, so they saturate at
+ * ULLONG_MAX.
+ * 
+ * Parameters:
+ *  int matches - The number of matching numbers on the card.
+ * 
+ * Returns:
+ *  unsigned long long int - The score of the card.
+*/
+inline unsigned long long int scoreMatches( int matches )
+{
+    if(matches <= 0)
+    {
+        return 0;
+    }
+    if(matches > 64)
+    {
+        return ULLONG_MAX;
+    }
+    return 1ULL << (matches - 1);
+}
+
+
+/**
+ * Sum the scores of a whole column of match counts. With AVX2 the scores of four cards are worked out at a time with
+ * a variable shift: 1 << (matches - 1), where the shift count wraps around to a huge one for no matches and so shifts
+ * the 1 out entirely, and lanes with more than 64 matches saturate like scoreMatches.
+ * 
+ * Parameters:
+ *  std::span<const int> matchCounts - The number of matches on each card.
+ * 
+ * Returns:
+ *  unsigned long long int - The sum of the scores of all of the cards.
+*/
+unsigned long long int scoreAll( std::span<const int> matchCounts )
+{
+    unsigned long long int sumOfPoints = 0;
+    size_t i = 0;
+#ifdef __AVX2__
+    const __m256i ones = _mm256_set1_epi64x(1);
+    const __m256i maxMatches = _mm256_set1_epi64x(64);
+    __m256i sums = _mm256_setzero_si256();
+    for(; i + 4 <= matchCounts.size(); i += 4)
+    {
+        __m256i matches = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(matchCounts.data() + i)));
+        __m256i scores = _mm256_sllv_epi64(ones, _mm256_sub_epi64(matches, ones));
+        scores = _mm256_or_si256(scores, _mm256_cmpgt_epi64(matches, maxMatches));
+        sums = _mm256_add_epi64(sums, scores);
+    }
+    alignas(32) unsigned long long int lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sums);
+    sumOfPoints = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for(; i < matchCounts.size(); i++)
+    {
+        sumOfPoints += scoreMatches(matchCounts[i]);
+    }
+    return sumOfPoints;
+}
+
+
+/**
+ * Scan a single line of the input file in one pass and without copying any part of it, handing each number on the
+ * card to onNumber as it is read. Shared by the parsers that fill in a ScratchCard and a ScratchDeck.
+ * 
+ * Parameters:
+ *  std::string_view line - A line of the input file, such as "Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53"
+ *  int & id - Set to the card's id.
+ *  OnNumber onNumber - Called as onNumber(bool isCandidate, int number) for each number after the colon.
+ * 
+ * Returns:
+ *  bool - True if the line held a card, false if it didn't (such as a blank line).
+*/
+template<typename OnNumber>
+bool scanScratchCard(   std::string_view line,
+                        int & id,
+                        OnNumber onNumber )
+{
+    size_t colon = line.find(':');
+    if(colon == std::string_view::npos)
+    {
+        return false;
+    }
+
+    //The card id is the number before the colon
+    id = 0;
+    for(size_t i = 0; i < colon; i++)
+    {
+        if( (line[i] >= '0') && (line[i] <= '9') )
+        {
+            id = (id * 10) + (line[i] - '0');
+        }
+    }
+
+    //Winning numbers come before the |, candidate numbers after it
+    bool readingCandidates = false;
+    bool inNumber = false;
+    int number = 0;
+    for(size_t i = colon + 1; i <= line.size(); i++)
+    {
+        char c = (i < line.size()) ? line[i] : ' ';
+        if( (c >= '0') && (c <= '9') )
+        {
+            number = (number * 10) + (c - '0');
+            inNumber = true;
+            continue;
+        }
+        if(inNumber)
+        {
+            onNumber(readingCandidates, number);
+            number = 0;
+            inNumber = false;
+        }
+        if(c == '|')
+        {
+            readingCandidates = true;
+        }
+    }
+    return true;
 }
 
 
 /**
  * Representation of the ScratchCard data for the day 4 problem.
+ * When every number on the card is below 128, the winning and candidate numbers are also kept as bitmasks and matches
+ * are counted with a single AND and popcount. Otherwise, if every number fits in 16 bits, matches are counted with the
+ * countMatchesLanes16 compare kernel, and failing that the winning numbers are kept sorted and each candidate is
+ * binary searched.
 */
 class ScratchCard
 {
     public:
         /*** Variables ***/
         int id; //The id number of the scratchcard
-        std::vector<int> candidateNumbers; //The numbers scratched off on the card.
-        std::unordered_map<int,int> winningNumbers; //The numbers that will earn points if seen in the candidate numbers. Keys are the winning numbers and values are zero.
+        SmallVector<int, 32> candidateNumbers; //The numbers scratched off on the card.
+        SmallVector<int, 16> winningNumbers; //The numbers that will earn points if seen in the candidate numbers, sorted in ascending order.
+        NumberMask128 winningMask; //The winning numbers as a bitmask. Only valid if fitsInMask.
+        NumberMask128 candidateMask; //The candidate numbers as a bitmask. Only valid if fitsInMask.
+        bool fitsInMask; //Whether every number on the card is below 128 and no candidate number repeats
+        int matchCount; //The number of candidate numbers that match winning numbers, filled in by cacheNumberOfMatches. Card data never changes, so this is computed once.
         int quantity; //The number of copies we have of this card
 
 
@@ -78,6 +365,8 @@ class ScratchCard
             id = 0;
             candidateNumbers = {};
             winningNumbers = {};
+            fitsInMask = true;
+            matchCount = 0;
             quantity = 1;
         }
 
@@ -85,110 +374,557 @@ class ScratchCard
         //Parametric constructor
         ScratchCard(    int idParam,
                         std::vector<int> candidateNumbersParam,
-                        std::unordered_map<int,int> winningNumbersParam  )
+                        std::vector<int> winningNumbersParam  )
         {
             id = idParam;
-            candidateNumbers = candidateNumbersParam;
-            winningNumbers = winningNumbersParam;
+            for(int i = 0; i < candidateNumbersParam.size(); i++)
+            {
+                candidateNumbers.push_back(candidateNumbersParam[i]);
+            }
+            for(int i = 0; i < winningNumbersParam.size(); i++)
+            {
+                winningNumbers.push_back(winningNumbersParam[i]);
+            }
             quantity = 1;
+            indexNumbers();
+            cacheNumberOfMatches();
         }
 
 
         /*** Methods ***/
+        /**
+         * Prepare the card's numbers for counting matches, once all of them have been added: sort the winning numbers
+         * and remove any repeats so they can be searched, and build the bitmasks if the numbers fit.
+        */
+        void indexNumbers()
+        {
+            //Keep the winning numbers sorted (and without repeats) so they can be binary searched
+            std::sort(winningNumbers.begin(), winningNumbers.end());
+            winningNumbers.truncate(std::unique(winningNumbers.begin(), winningNumbers.end()) - winningNumbers.begin());
+
+            //Build the bitmasks if every number fits. A repeated candidate number would only set its bit once, so a
+            //card with one falls back to the sorted search to count each repeat as its own match.
+            fitsInMask = true;
+            for(int i = 0; (i < winningNumbers.size()) && fitsInMask; i++)
+            {
+                fitsInMask = NumberMask128::fits(winningNumbers[i]);
+                if(fitsInMask)
+                {
+                    winningMask.add(winningNumbers[i]);
+                }
+            }
+            for(int i = 0; (i < candidateNumbers.size()) && fitsInMask; i++)
+            {
+                fitsInMask = NumberMask128::fits(candidateNumbers[i]) && candidateMask.add(candidateNumbers[i]);
+            }
+        }
+
+
         /**
          * Calculate the score of the scratchcard and return it as an integer.
          * The first match you get on a card gives one point, and all further matches change the point value of the card to double of 
          * its previous value.
         */
-        int getScore()
+        unsigned long long int getScore() const
         {
-            int matches = getNumberOfMatches();
-            return (int)pow( 2, (matches-1) );
+            return scoreMatches(getNumberOfMatches());
         }
 
 
         /**
          * Returns the integer number of candidate numbers that match with winning numbers.
         */
-        int getNumberOfMatches()
+        int getNumberOfMatches() const
         {
-            int matches = 0;
-            //Iterate through all of the candidate numbers
-            for(int i = 0; i < candidateNumbers.size(); i++)
+            return matchCount;
+        }
+
+
+        /**
+         * Count the matches and store them in matchCount. The parametric constructor calls this itself; a card filled
+         * in by parseScratchCard needs it called once its numbers are in. ScratchDeck counts its cards' matches itself.
+        */
+        void cacheNumberOfMatches()
+        {
+            matchCount = countMatches();
+        }
+
+
+        /**
+         * Count the candidate numbers that match with winning numbers. Used to fill in matchCount; everything else
+         * should use getNumberOfMatches.
+        */
+        int countMatches() const
+        {
+            if(fitsInMask)
+            {
+                return winningMask.countCommon(candidateMask);
+            }
+            return countMatchesSorted(winningNumbers.data(), winningNumbers.size(), candidateNumbers.data(), candidateNumbers.size());
+        }
+
+
+    private:
+};
+
+
+/**
+ * A whole deck of scratchcards, stored column by column rather than card by card. Every column lives in one arena
+ * allocation, padded out to whole cache lines, so the passes over the deck are linear scans of contiguous memory.
+ * The numbers of card i are winningPool[winningOffsets[i]] up to winningPool[winningOffsets[i+1]], and likewise for
+ * the candidate numbers. The deck owns its arena, so it can be moved but not copied.
+*/
+class ScratchDeck
+{
+    public:
+        /*** Columns ***/
+        int * ids = nullptr; //The id of each card.
+        NumberMask128 * winningMasks = nullptr; //The winning numbers of each card as a bitmask. Only valid if fitsInMask.
+        unsigned char * fitsInMask = nullptr; //Whether every number on each card is below 128 and its candidates don't repeat.
+        int * winningOffsets = nullptr; //Where each card's winning numbers start in winningPool. Has one entry more than there are cards.
+        int * winningPool = nullptr; //The winning numbers of every card, each card's sorted and without repeats.
+        int * candidateOffsets = nullptr; //Where each card's candidate numbers start in candidatePool. Has one entry more than there are cards.
+        int * candidatePool = nullptr; //The candidate numbers of every card.
+        int * matchCounts = nullptr; //The number of matches on each card, once computeMatchCounts has run.
+        unsigned long long int * quantities = nullptr; //The number of original copies of each card.
+
+
+        /*** Constructors ***/
+        ScratchDeck() = default;
+
+
+        /**
+         * Allocate a deck with room for the given numbers of cards, winning numbers and candidate numbers.
+        */
+        ScratchDeck(    int cardCapacityParam,
+                        int winningCapacityParam,
+                        int candidateCapacityParam )
+        {
+            cardCapacity = cardCapacityParam;
+            winningCapacity = winningCapacityParam;
+            candidateCapacity = candidateCapacityParam;
+
+            //Size the arena, then carve the columns out of it in order
+            size_t arenaSize = columnBytes<int>(cardCapacity) + columnBytes<NumberMask128>(cardCapacity)
+                             + columnBytes<unsigned char>(cardCapacity) + columnBytes<int>(cardCapacity + 1)
+                             + columnBytes<int>(winningCapacity) + columnBytes<int>(cardCapacity + 1)
+                             + columnBytes<int>(candidateCapacity) + columnBytes<int>(cardCapacity)
+                             + columnBytes<unsigned long long int>(cardCapacity);
+            arena = std::make_unique<std::byte[]>(arenaSize);
+            std::byte * next = arena.get();
+            ids = carveColumn<int>(next, cardCapacity);
+            winningMasks = carveColumn<NumberMask128>(next, cardCapacity);
+            fitsInMask = carveColumn<unsigned char>(next, cardCapacity);
+            winningOffsets = carveColumn<int>(next, cardCapacity + 1);
+            winningPool = carveColumn<int>(next, winningCapacity);
+            candidateOffsets = carveColumn<int>(next, cardCapacity + 1);
+            candidatePool = carveColumn<int>(next, candidateCapacity);
+            matchCounts = carveColumn<int>(next, cardCapacity);
+            quantities = carveColumn<unsigned long long int>(next, cardCapacity);
+
+            winningOffsets[0] = 0;
+            candidateOffsets[0] = 0;
+        }
+
+
+        /*** Methods ***/
+        /**
+         * Returns the number of cards in the deck.
+        */
+        int size() const
+        {
+            return cardCount;
+        }
+
+
+        /**
+         * Parse a line of the input file straight onto the end of the deck, writing its numbers into the pools at the
+         * deck's current offsets. The winning numbers are then sorted and their repeats removed in place, and the
+         * bitmask is built if the numbers fit. Its match count is left at 0 until computeMatchCounts runs.
+         * 
+         * Parameters:
+         *  std::string_view line - A line of the input file, such as "Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53"
+         * 
+         * Returns:
+         *  bool - True if the line held a card, false if it didn't (such as a blank line).
+        */
+        bool appendCard( std::string_view line )
+        {
+            int i = cardCount;
+            int * winningStart = winningPool + winningOffsets[i];
+            int * winningEnd = winningStart;
+            int * candidateStart = candidatePool + candidateOffsets[i];
+            int * candidateEnd = candidateStart;
+            bool fits = true;
+            NumberMask128 candidateMask;
+            bool roomLeft = true;
+            int id = 0;
+            bool isCard = scanScratchCard(line, id, [&]( bool isCandidate, int number )
             {
-                //Check to see if the candidate number is a winning number
-                if(winningNumbers.contains(candidateNumbers[i]))
+                if(isCandidate)
+                {
+                    roomLeft = roomLeft && (candidateEnd < candidatePool + candidateCapacity);
+                    if(roomLeft)
+                    {
+                        *candidateEnd++ = number;
+                        //A repeated candidate number would only set its bit once, so a card with one falls back to
+                        //the sorted search to count each repeat as its own match
+                        fits = fits && NumberMask128::fits(number) && candidateMask.add(number);
+                    }
+                }
+                else
                 {
-                    matches++;
+                    roomLeft = roomLeft && (winningEnd < winningPool + winningCapacity);
+                    if(roomLeft)
+                    {
+                        *winningEnd++ = number;
+                    }
                 }
+            });
+            if(!isCard)
+            {
+                return false;
+            }
+            if( (cardCount == cardCapacity) || !roomLeft )
+            {
+                std::cout << "There was a problem and card " << id << " did not fit in the scratchcard deck." << std::endl;
+                exit(EXIT_FAILURE);
             }
-            return matches;
+
+            //Keep the winning numbers sorted (and without repeats) so they can be binary searched
+            std::sort(winningStart, winningEnd);
+            winningEnd = std::unique(winningStart, winningEnd);
+            winningMasks[i] = NumberMask128();
+            for(const int * number = winningStart; (number < winningEnd) && fits; number++)
+            {
+                fits = NumberMask128::fits(*number);
+                if(fits)
+                {
+                    winningMasks[i].add(*number);
+                }
+            }
+
+            ids[i] = id;
+            fitsInMask[i] = fits;
+            winningOffsets[i + 1] = winningEnd - winningPool;
+            candidateOffsets[i + 1] = candidateEnd - candidatePool;
+            matchCounts[i] = 0;
+            quantities[i] = 1;
+            cardCount++;
+            return true;
+        }
+
+
+        /**
+         * Count the candidate numbers of card i that match with its winning numbers. Used to fill in matchCounts.
+        */
+        int countMatches( int i ) const
+        {
+            const int * candidates = candidatePool + candidateOffsets[i];
+            int candidateCount = candidateOffsets[i + 1] - candidateOffsets[i];
+            if(fitsInMask[i])
+            {
+                NumberMask128 candidateMask;
+                for(int j = 0; j < candidateCount; j++)
+                {
+                    candidateMask.add(candidates[j]);
+                }
+                return winningMasks[i].countCommon(candidateMask);
+            }
+            return countMatchesSorted(  winningPool + winningOffsets[i], winningOffsets[i + 1] - winningOffsets[i],
+                                        candidates, candidateCount );
         }
 
 
     private:
+        std::unique_ptr<std::byte[]> arena = nullptr;
+        int cardCount = 0;
+        int cardCapacity = 0;
+        int winningCapacity = 0;
+        int candidateCapacity = 0;
+
+        //The bytes a column of count Ts takes up in the arena, rounded up to a whole number of cache lines
+        template<typename T>
+        static size_t columnBytes( int count )
+        {
+            return ((count * sizeof(T)) + 63) / 64 * 64;
+        }
+
+        //Hand out the next column of the arena
+        template<typename T>
+        static T * carveColumn( std::byte * & next,
+                                int count )
+        {
+            T * column = reinterpret_cast<T *>(next);
+            next += columnBytes<T>(count);
+            return column;
+        }
 };
 
 
 /**
  * Part 1 of the day 4 problem:
- * Given a bunch of ScratchCard objects as input, determine the sum of all of their scores.
+ * Given a deck of scratchcards as input, determine the sum of all of their scores.
  * 
  * Parameter:
- *  std::vector< ScratchCard > scratchCards - The collection of scratchcards which we are summing the scores of.
+ *  const ScratchDeck & deck - The deck of scratchcards which we are summing the scores of.
  * 
  * Returns:
- *  int - The sum of all of the scratchcard scores.
+ *  unsigned long long int - The sum of all of the scratchcard scores.
 */
-int findTotalPointsOfScratchCards(  std::vector< ScratchCard > scratchCards )
+unsigned long long int findTotalPointsOfScratchCards(  const ScratchDeck & deck )
 {
-    //Initialize our sum
-    int sumOfPoints = 0;
+    //Score the whole match count column at once
+    return scoreAll(std::span<const int>(deck.matchCounts, deck.size()));
+}
 
-    //For each scratchcard, add its points to the sum
-    for(int i = 0; i < scratchCards.size(); i++)
-    {
-        sumOfPoints += scratchCards[i].getScore();
-    }
-    
-    return sumOfPoints;
+
+/**
+ * Report that the number of scratchcards is too large to count in 64 bits and stop, rather than giving a total that
+ * has silently wrapped around.
+*/
+void exitTooManyScratchCards()
+{
+    std::cout << "There was a problem and the total number of scratchcards is too large to count." << std::endl;
+    exit(EXIT_FAILURE);
 }
 
 
 /**
  * Part 2 of the day 4 problem:
- * Given a bunch of ScratchCard objects as input, where each ScratchCard earns you copies of the next X ScratchCards for having X winning numbers,
+ * Given a deck of scratchcards as input, where each ScratchCard earns you copies of the next X ScratchCards for having X winning numbers,
  * determine how many total scratchcards you have in total by summing the original quantity of cards with all of the copies you've won.
  * 
+ * Rather than adding a card's copies to each of the next X cards one at a time, we keep a running count of the copies
+ * won: a card's copies are added to it once the card is counted, and taken off again at the card just past the end of
+ * its run of won cards. This is O(n) no matter how many cards are won. The running count and the total only ever hold
+ * real numbers of cards, so they are added with overflow checks and a total that doesn't fit stops the program.
+ * 
  * Parameter:
- *  std::vector< ScratchCard > scratchCards - A vector containing all of the ScratchCards.
+ *  const ScratchDeck & deck - The deck of scratchcards. It is not modified.
  * 
  * Returns:
- *  int - The total number of all scratchcards after we've figured out how many copies we've won.
+ *  unsigned long long int - The total number of all scratchcards after we've figured out how many copies we've won.
 */
-int findTotalNumberOfScratchCards(  std::vector<ScratchCard> scratchCards )
+unsigned long long int findTotalNumberOfScratchCards(   const ScratchDeck & deck )
 {
+    int cardCount = deck.size();
+    //expiringCopies[i] is the copies won by the cards whose runs of won cards end just before card i
+    std::vector<unsigned long long int> expiringCopies(cardCount + 1, 0);
+    unsigned long long int copiesWon = 0;
     //Initialize the total number of scratchcards
-    int cardTotal = 0;
+    unsigned long long int cardTotal = 0;
 
-    //std::cout << "Total number of scratchcards BEFORE reading them: " << scratchCards.size() << std::endl;
+    for(int i = 0; i < cardCount; i++)
+    {
+        //Find how many copies of this card we have, and add them to the total
+        copiesWon -= expiringCopies[i];
+        unsigned long long int copies;
+        if( __builtin_add_overflow(deck.quantities[i], copiesWon, &copies)
+         || __builtin_add_overflow(cardTotal, copies, &cardTotal) )
+        {
+            exitTooManyScratchCards();
+        }
+        //Each copy wins a copy of each of the next nextCardsWon cards, as long as those cards exist
+        int nextCardsWon = std::min(deck.matchCounts[i], cardCount - 1 - i);
+        if(nextCardsWon > 0)
+        {
+            if(__builtin_add_overflow(copiesWon, copies, &copiesWon))
+            {
+                exitTooManyScratchCards();
+            }
+            //Never more than cardTotal, so this can't overflow
+            expiringCopies[i + 1 + nextCardsWon] += copies;
+        }
+    }
+
+    return cardTotal;
+}
+
+
+/**
+ * Split the range [0, count) into threadCount contiguous blocks and call work(blockStart, blockEnd) for each block on
+ * its own thread, returning once every block is done.
+ * 
+ * Parameters:
+ *  int count - The size of the range.
+ *  int threadCount - The number of blocks/threads.
+ *  const std::function<void(int, int, int)> & work - Called with the block number, the start of the block (inclusive) and the end of the block (exclusive).
+*/
+void parallelForBlocks( int count,
+                        int threadCount,
+                        const std::function<void(int, int, int)> & work )
+{
+    threadCount = std::max(1, std::min(threadCount, count));
+    int blockSize = (count + threadCount - 1) / threadCount;
+    std::vector<std::thread> threads = {};
+    for(int block = 0; block < threadCount; block++)
+    {
+        int blockStart = std::min(block * blockSize, count);
+        int blockEnd = std::min(blockStart + blockSize, count);
+        threads.emplace_back(work, block, blockStart, blockEnd);
+    }
+    for(int i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+}
+
+
+/**
+ * Phase one of the two-phase executor: count the matches of every scratchcard, in parallel across threadCount
+ * threads. Each card is independent, so each thread just takes a contiguous block of cards.
+ * 
+ * Parameters:
+ *  ScratchDeck & deck - The deck whose match counts we are filling in.
+ *  int threadCount - The number of threads to use.
+*/
+void computeMatchCounts(    ScratchDeck & deck,
+                            int threadCount )
+{
+    parallelForBlocks(deck.size(), threadCount, [&deck](int, int blockStart, int blockEnd)
+    {
+        for(int i = blockStart; i < blockEnd; i++)
+        {
+            deck.matchCounts[i] = deck.countMatches(i);
+        }
+    });
+}
+
+
+/**
+ * Phase two of the two-phase executor, part 2 of the day 4 problem: the same answer as findTotalNumberOfScratchCards,
+ * computed as a blocked scan across threadCount threads.
+ * 
+ * Let W be the largest match count. Everything a block of cards needs from the cards before it is the copies already
+ * won for its first W cards, and everything it passes on is the copies won for the W cards after it, along with the
+ * number of cards in the block. Both are affine in the incoming copies. So each thread works out its block's affine
+ * map by propagating through the block once with no incoming copies and once for each of the W incoming positions,
+ * and then the maps are chained together in order. The maps cost W + 1 passes over each block, so this only beats
+ * the sequential propagation when there are more than W + 1 threads; otherwise we fall back to it.
+ * 
+ * Every step is checked for overflow. A block map can overflow even when the real total doesn't (a copy coming in at
+ * a position that never actually receives one), so on any overflow we fall back to findTotalNumberOfScratchCards,
+ * which gives the exact total or reports that it is too large.
+ * 
+ * Parameters:
+ *  const ScratchDeck & deck - The deck of scratchcards. It is not modified.
+ *  int threadCount - The number of threads to use.
+ * 
+ * Returns:
+ *  unsigned long long int - The total number of all scratchcards after we've figured out how many copies we've won.
+*/
+unsigned long long int findTotalNumberOfScratchCardsParallel(   const ScratchDeck & deck,
+                                                                int threadCount )
+{
+    int cardCount = deck.size();
+    int window = 0;
+    for(int i = 0; i < cardCount; i++)
+    {
+        window = std::max(window, std::min(deck.matchCounts[i], cardCount - 1 - i));
+    }
+    threadCount = std::min(threadCount, cardCount);
+    if((window == 0) || (threadCount <= window + 1))
+    {
+        return findTotalNumberOfScratchCards(deck);
+    }
+
+    //The affine map of each block: outgoing = linear * incoming + constant, and cardTotal = totalLinear . incoming + totalConstant
+    struct BlockMap
+    {
+        std::vector<unsigned long long int> linear; //window x window, row-major
+        std::vector<unsigned long long int> constant;
+        std::vector<unsigned long long int> totalLinear;
+        unsigned long long int totalConstant = 0;
+        bool overflowed = false;
+    };
+    std::vector<BlockMap> blockMaps(threadCount);
+
+    parallelForBlocks(cardCount, threadCount, [&](int block, int blockStart, int blockEnd)
+    {
+        BlockMap & blockMap = blockMaps[block];
+        blockMap.linear.assign(window * window, 0);
+        blockMap.constant.assign(window, 0);
+        blockMap.totalLinear.assign(window, 0);
+        int blockLength = blockEnd - blockStart;
+        std::vector<unsigned long long int> expiringCopies(blockLength + window + 1);
+
+        //Pass -1 finds the constant part (the cards' own quantities, nothing incoming). Pass k finds the linear part
+        //for incoming position k (one incoming copy at position k, no quantities).
+        for(int pass = -1; (pass < window) && !blockMap.overflowed; pass++)
+        {
+            std::fill(expiringCopies.begin(), expiringCopies.end(), 0);
+            unsigned long long int copiesWon = 0;
+            unsigned long long int cardTotal = 0;
+            for(int j = 0; (j < blockLength) && !blockMap.overflowed; j++)
+            {
+                int i = blockStart + j;
+                copiesWon -= expiringCopies[j];
+                unsigned long long int copies;
+                blockMap.overflowed = __builtin_add_overflow(copiesWon, (pass == -1) ? deck.quantities[i] : (j == pass), &copies)
+                                   || __builtin_add_overflow(cardTotal, copies, &cardTotal);
+                int nextCardsWon = std::min(deck.matchCounts[i], cardCount - 1 - i);
+                if( (nextCardsWon > 0) && !blockMap.overflowed )
+                {
+                    blockMap.overflowed = __builtin_add_overflow(copiesWon, copies, &copiesWon);
+                    expiringCopies[j + 1 + nextCardsWon] += copies;
+                }
+            }
+            //The copies won so far by each of the window cards after the block
+            for(int d = 0; (d < window) && !blockMap.overflowed; d++)
+            {
+                copiesWon -= expiringCopies[blockLength + d];
+                unsigned long long int outgoing;
+                blockMap.overflowed = __builtin_add_overflow(copiesWon, (pass != -1) && (blockLength + d == pass), &outgoing);
+                if(pass == -1)
+                {
+                    blockMap.constant[d] = outgoing;
+                }
+                else
+                {
+                    blockMap.linear[(d * window) + pass] = outgoing;
+                }
+            }
+            if(pass == -1)
+            {
+                blockMap.totalConstant = cardTotal;
+            }
+            else
+            {
+                blockMap.totalLinear[pass] = cardTotal;
+            }
+        }
+    });
 
-    //For each scratchcard, add its quantity to the cardTotal and find out how many copies of future cards it wins
-    for(int i = 0; i < scratchCards.size(); i++)
+    //Chain the block maps together in order
+    std::vector<unsigned long long int> incoming(window, 0);
+    std::vector<unsigned long long int> outgoing(window, 0);
+    unsigned long long int cardTotal = 0;
+    bool overflowed = false;
+    for(int block = 0; (block < threadCount) && !overflowed; block++)
     {
-        cardTotal += scratchCards[i].quantity;
-        int nextCardsWon = scratchCards[i].getNumberOfMatches();
-        int copiesOfNextCards = scratchCards[i].quantity;
-        int c = i + 1;
-        while( nextCardsWon > 0)
+        const BlockMap & blockMap = blockMaps[block];
+        overflowed = blockMap.overflowed || __builtin_add_overflow(cardTotal, blockMap.totalConstant, &cardTotal);
+        unsigned long long int term;
+        for(int k = 0; (k < window) && !overflowed; k++)
+        {
+            overflowed = __builtin_mul_overflow(blockMap.totalLinear[k], incoming[k], &term)
+                      || __builtin_add_overflow(cardTotal, term, &cardTotal);
+        }
+        for(int d = 0; (d < window) && !overflowed; d++)
         {
-            if(c < scratchCards.size())
+            outgoing[d] = blockMap.constant[d];
+            for(int k = 0; (k < window) && !overflowed; k++)
             {
-                scratchCards[c].quantity += copiesOfNextCards;  
+                overflowed = __builtin_mul_overflow(blockMap.linear[(d * window) + k], incoming[k], &term)
+                          || __builtin_add_overflow(outgoing[d], term, &outgoing[d]);
             }
-            c++;
-            nextCardsWon--;
         }
+        incoming.swap(outgoing);
+    }
+    if(overflowed)
+    {
+        return findTotalNumberOfScratchCards(deck);
     }
 
     return cardTotal;
@@ -196,73 +932,191 @@ int findTotalNumberOfScratchCards(  std::vector<ScratchCard> scratchCards )
 
 
 /**
- * Reads the input file in and creates a std::vector of ScratchCard objects we can work with.
+ * Parse a single line of the input file into a ScratchCard, for when cards are streamed one at a time.
+ * The numbers are written straight into the card's inline number lists.
  * 
- * Parameter:
+ * Parameters:
+ *  std::string_view line - A line of the input file, such as "Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53"
+ *  ScratchCard & card - An empty card to parse the line into.
+ * 
+ * Returns:
+ *  bool - True if the line held a card, false if it didn't (such as a blank line).
+*/
+bool parseScratchCard(  std::string_view line,
+                        ScratchCard & card )
+{
+    bool isCard = scanScratchCard(line, card.id, [&card]( bool isCandidate, int number )
+    {
+        if(isCandidate)
+        {
+            card.candidateNumbers.push_back(number);
+        }
+        else
+        {
+            card.winningNumbers.push_back(number);
+        }
+    });
+    if(!isCard)
+    {
+        return false;
+    }
+
+    card.indexNumbers();
+    return true;
+}
+
+
+/**
+ * Reads the input file in and creates a ScratchDeck we can work with.
+ * The file is read in one block and scanned once to size the deck, so the deck is allocated up front, and then each
+ * line is parsed straight into the deck's flat number pools. The match counts of the cards are computed in parallel once all of the cards
+ * have been read.
+ * 
+ * Parameters:
  *  std::string inputFileName - The std::string name of the file that will be used to read scratchcard data into objects.
+ *  int threadCount - The number of threads to count matches with.
  * 
  * Returns:
- *  std::vector< ScratchCard > - A std::vector container of ScratchCard objects that we'll be able to use for this problem.
+ *  ScratchDeck - The deck of scratchcards that we'll be able to use for this problem.
 */
-std::vector< ScratchCard > readScratchCards( std::string inputFileName )
+ScratchDeck readScratchCards(  std::string inputFileName,
+                                int threadCount = 1 )
 {
     //Open the file
-    std::fstream file(inputFileName);
+    std::ifstream file(inputFileName, std::ios::binary | std::ios::ate);
     std::cout << "Opening scratchcard file...\n";
     if(!file.is_open())
     {
         std::cout << "There was a problem and we were unable to open a file with the name:'" << inputFileName << "'" << std::endl;
         exit(EXIT_FAILURE);
     }
-    //File is ready!
+    //File is ready! Read the whole thing in one block.
     std::cout << "Succesfully opened scratchcard file!\n";
+    std::string contents(file.tellg(), '\0');
+    file.seekg(0);
+    file.read(contents.data(), contents.size());
+    file.close();
+
+    //Count the lines and the runs of digits on either side of each | so the deck can be allocated in one go. The card
+    //ids are counted with the winning numbers, so these are upper bounds.
+    int lineCount = 1;
+    int winningCount = 0;
+    int candidateCount = 0;
+    bool afterBar = false;
+    for(size_t i = 0; i < contents.size(); i++)
+    {
+        char c = contents[i];
+        if(c == '\n')
+        {
+            lineCount++;
+            afterBar = false;
+        }
+        else if(c == '|')
+        {
+            afterBar = true;
+        }
+        else if( (c >= '0') && (c <= '9') && ((i == 0) || (contents[i-1] < '0') || (contents[i-1] > '9')) )
+        {
+            (afterBar ? candidateCount : winningCount)++;
+        }
+    }
+    ScratchDeck deck(lineCount, winningCount, candidateCount);
 
-    //We'll be using a string lib to slice up the data
-    stevensStringLib stringLib = stevensStringLib();
-    //We also need a place to store our scrachcards as we read them:
-    std::vector< ScratchCard > scratchCards = {};
     //Go through each line of the input file and read the scrachcard data
+    std::string_view remaining(contents);
+    while(!remaining.empty())
+    {
+        size_t lineEnd = std::min(remaining.find('\n'), remaining.size());
+        deck.appendCard(remaining.substr(0, lineEnd));
+        remaining.remove_prefix(std::min(lineEnd + 1, remaining.size()));
+    }
+    std::cout << "Read all scratchcards!" << std::endl;
+
+    computeMatchCounts(deck, threadCount);
+
+    return deck;
+}
+
+
+/**
+ * The answers to both parts of the day 4 problem.
+*/
+struct ScratchCardTotals
+{
+    unsigned long long int totalPoints = 0;
+    unsigned long long int totalCards = 0;
+};
+
+
+/**
+ * Read scratchcards from a stream and find the answers to both parts without ever holding more than one card.
+ * 
+ * A card can only win copies of the cards that come after it, and never more of them than it has matches. So the only
+ * state we need to carry from card to card is the running count of copies won and the copies that drop out of it at
+ * each of the next few cards (see findTotalNumberOfScratchCards). We keep the latter in a ring buffer that is only as
+ * long as the largest match count seen so far, so memory is O(window) however many cards are read.
+ * 
+ * Parameter:
+ *  std::istream & input - The stream to read scratchcards from, one per line.
+ * 
+ * Returns:
+ *  ScratchCardTotals - The total points of all scratchcards (part 1) and the total number of scratchcards (part 2).
+*/
+ScratchCardTotals streamScratchCards( std::istream & input )
+{
+    ScratchCardTotals totals;
+    //expiringCopies[(head + d) % size] is the copies won by the cards whose runs of won cards end just before the card d ahead
+    std::vector<unsigned long long int> expiringCopies(1, 0);
+    int head = 0;
+    unsigned long long int copiesWon = 0;
+
     std::string line;
-    while( getline( file, line ) )
-    {
-        //Separate the card id from the numbers
-        std::vector<std::string> cardIdAndNumbers = stringLib.separate(line, ":");
-        int cardId = std::stoi(eraseNonNumericChars(cardIdAndNumbers[0]));
-        //std::cout << "stoi works for cardId" << std::endl;
-        //Separate the winning numbers from the candidate numbers
-        std::vector<std::string> candidateAndWinningNumbers = stringLib.separate(cardIdAndNumbers[1], "|");
-        //Load the candidate numbers into a vector of integers
-        std::vector<std::string> candidateNumbers_str = stringLib.separate( stringLib.trimWhitespace(candidateAndWinningNumbers[1]), " ");
-        std::vector<int> candidateNumbers = {};
-        for(int i = 0; i < candidateNumbers_str.size(); i++)
-        {
-            if(candidateNumbers_str[i] != "")
-            {
-                candidateNumbers.push_back(std::stoi(candidateNumbers_str[i]));
-            }
+    while( getline( input, line ) )
+    {
+        ScratchCard card;
+        if(!parseScratchCard(line, card))
+        {
+            continue;
         }
-        //Load the winning numbers into an unordered map
-        std::vector<std::string> winningNumbers_str = stringLib.separate( stringLib.trimWhitespace(candidateAndWinningNumbers[0]), " ");
-        std::unordered_map<int,int> winningNumbers;
-        for(int i = 0; i < winningNumbers_str.size(); i++)
+        card.cacheNumberOfMatches();
+        int matches = card.getNumberOfMatches();
+
+        //Part 1
+        totals.totalPoints += scoreMatches(matches);
+
+        //Part 2: find how many copies of this card we have, then move the window on to the next card
+        copiesWon -= expiringCopies[head];
+        expiringCopies[head] = 0;
+        unsigned long long int copies;
+        if( __builtin_add_overflow(static_cast<unsigned long long int>(card.quantity), copiesWon, &copies)
+         || __builtin_add_overflow(totals.totalCards, copies, &totals.totalCards) )
+        {
+            exitTooManyScratchCards();
+        }
+        head = (head + 1) % expiringCopies.size();
+
+        if(matches > 0)
         {
-            if(winningNumbers_str[i] != "")
+            //Grow the ring buffer if this card wins further ahead than it can reach, keeping the entries in order
+            if(matches + 1 > expiringCopies.size())
             {
-                winningNumbers[std::stoi(winningNumbers_str[i])] = 0;
+                std::vector<unsigned long long int> grown(matches + 1, 0);
+                for(int d = 0; d < expiringCopies.size(); d++)
+                {
+                    grown[d] = expiringCopies[(head + d) % expiringCopies.size()];
+                }
+                expiringCopies.swap(grown);
+                head = 0;
+            }
+            if(__builtin_add_overflow(copiesWon, copies, &copiesWon))
+            {
+                exitTooManyScratchCards();
             }
+            expiringCopies[(head + matches) % expiringCopies.size()] += copies;
         }
-        //Construct the scratchcard
-        ScratchCard card = ScratchCard( cardId, candidateNumbers, winningNumbers);
-        //Add it to the vector
-        scratchCards.push_back(card);
-        //std::cout << "scratchcard pushed back!" << std::endl;
     }
-    std::cout << "Read all scratchcards!" << std::endl;
-
-    //Close the file
-    file.close();
 
-    return scratchCards;
+    return totals;
 }
 
 
@@ -289,8 +1143,44 @@ int main( int argc, char * argv[])
         return 1;
     }
 
+    //Stream the file instead of loading it, for card feeds of any length. Use -f - to read from stdin.
+    if(inputParser.cmdOptionExists("-s"))
+    {
+        std::ifstream file;
+        if(inputFileName != "-")
+        {
+            file.open(inputFileName);
+            if(!file.is_open())
+            {
+                std::cout << "There was a problem and we were unable to open a file with the name:'" << inputFileName << "'" << std::endl;
+                return 1;
+            }
+        }
+        ScratchCardTotals totals = streamScratchCards( (inputFileName == "-") ? std::cin : file );
+        if(partToExecute == "1")
+        {
+            std::cout << "Total points of all scratchcards: " << totals.totalPoints << std::endl;
+        }
+        if(partToExecute == "2")
+        {
+            std::cout << "Total number of scratchcards: " << totals.totalCards << std::endl;
+        }
+        return 0;
+    }
+
+    //Use -j <THREADS> to count matches and propagate copies across multiple threads. 0 uses every available core.
+    int threadCount = 1;
+    if(inputParser.cmdOptionExists("-j"))
+    {
+        threadCount = std::stoi(inputParser.getCmdOption("-j"));
+        if(threadCount <= 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
     //Read in the file
-    std::vector< ScratchCard > scratchCards  = readScratchCards( inputFileName );
+    ScratchDeck deck = readScratchCards( inputFileName, threadCount );
 
     if(partToExecute == "1")
     {
@@ -300,7 +1190,7 @@ int main( int argc, char * argv[])
             auto start = std::chrono::high_resolution_clock::now();
             for(int i = 0; i < 1000; i++)
             {
-                findTotalPointsOfScratchCards( scratchCards );
+                findTotalPointsOfScratchCards( deck );
             }
             auto stop = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
@@ -309,7 +1199,7 @@ int main( int argc, char * argv[])
         //Execute normally
         else
         {
-        int totalPoints = findTotalPointsOfScratchCards( scratchCards );
+        unsigned long long int totalPoints = findTotalPointsOfScratchCards( deck );
         std::cout << "Total points of all scratchcards: " << totalPoints << std::endl;
         }
     }
@@ -321,7 +1211,7 @@ int main( int argc, char * argv[])
             auto start = std::chrono::high_resolution_clock::now();
             for(int i = 0; i < 1000; i++)
             {
-                findTotalNumberOfScratchCards( scratchCards );
+                findTotalNumberOfScratchCardsParallel( deck, threadCount );
             }
             auto stop = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
@@ -330,7 +1220,7 @@ int main( int argc, char * argv[])
         //Execute normally
         else
         {
-            int cardCount = findTotalNumberOfScratchCards( scratchCards );
+            unsigned long long int cardCount = findTotalNumberOfScratchCardsParallel( deck, threadCount );
             std::cout << "Total number of scratchcards: " << cardCount << std::endl;
         }
     }
@@ -7,9 +7,19 @@
 #include <vector>
 #include <tuple>
 #include <map>
+#include <stdexcept>
 #include <fstream>
 #include <algorithm>
 #include <chrono>
+#include <climits>
+#include <optional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 #include "InputParser.h"
 #include "stevensStringLib.h"
 
@@ -77,52 +87,6 @@ T find_min( const std::vector<T> vec)
 }
 
 
-/**
- * TOOD: How to make this only work for numerical types?
- * 
- * Given a lower bound and upper bound of some numerical type, check to see if a variable in within the range specified by the upper and lower bounds.
- * If it is, return true. Otherwise, return false.
- * 
- * Parameters:
- *  const T checkValue - The value which we are checking to see if it falls between the bounds
- *  const T lowerBound - The smaller value we are checking to see if our value is greater than/greater than or equal to.
- *  const T upperBound - The bigger  value we are checking to see if our value is less than/less than or equal to.
- *  std::string boundSetting - The way which we are treating the edge cases of our range checking. Possible values are:
- *                                  "exclusive" - Bounds are checked using > and < signs
- *                                  "inclusive" - Bounds are checked using >= and <= signs
- * 
- * Returns:
- *  bool - True if the checkValue falls within the bounds, False otherwise.
-*/
-template<typename T>
-bool in_range(  const T checkValue,
-                const T lowerBound,
-                const T upperBound,
-                std::string boundSetting = "exclusive"  )
-{
-    if(boundSetting == "exclusive")
-    {
-        if((checkValue > lowerBound) && (checkValue < upperBound))
-        {
-            return true;
-        }
-    }
-    else if (boundSetting == "inclusive")
-    {
-        if((checkValue >= lowerBound) && (checkValue <= upperBound))
-        {
-            return true;
-        }
-    }
-    else
-    {
-        std::cerr << "StevensMathLib Error: in_range: Could not recognize the boundSetting parameter '" << boundSetting << "'." << std::endl;
-    }
-
-    return false;
-}
-
-
 /**
  * Used during reading in the file for advent of code 2023 day 5. Stores data about an individual line from the input file:
  * -Source range start
@@ -159,20 +123,270 @@ class MappingRange
 
 
 /**
- * Class representing the mappings of seed_to_soil, soil_to_fertilizer, fertilizer_to_water, water_to_light, light_to_temperature, temperature_to_humidity,
- * and humidity_to_location for all of the seeds on island island!
+ * One stage of the almanac compiled for fast lookups. The whole number line is cut into pieces at the ends of the
+ * mapping ranges, and every number in a piece is shifted by the same offset: the range's offset inside a mapping range,
+ * and 0 in the gaps between them. The pieces are kept sorted by their starts, so looking up a number is a binary
+ * search for the last piece that starts at or before it. The mapping ranges of a stage must not overlap, which
+ * readInput checks.
+*/
+class MappingTable
+{
+    public:
+        /*** Variables ***/
+        std::vector<long long int> pieceStarts; //The first number of each piece. The first piece starts at LLONG_MIN.
+        std::vector<long long int> pieceOffsets; //What each number in the piece is shifted by.
+
+        /*** Constructors ***/
+        //Default: every number maps to itself
+        MappingTable()
+        {
+            pieceStarts = { LLONG_MIN };
+            pieceOffsets = { 0 };
+        }
+
+
+        //Parametric
+        MappingTable( const std::vector<MappingRange> & almanacMapping )
+        {
+            std::vector<MappingRange> sortedMapping = almanacMapping;
+            std::sort(sortedMapping.begin(), sortedMapping.end(), [](const MappingRange & a, const MappingRange & b)
+            {
+                return a.sourceRangeStart < b.sourceRangeStart;
+            });
+
+            //Start with one gap covering everything, then cut a piece out of the gap after it for each mapping range
+            pieceStarts = { LLONG_MIN };
+            pieceOffsets = { 0 };
+            long long int coveredEnd = LLONG_MIN;
+            for(int i = 0; i < sortedMapping.size(); i++)
+            {
+                long long int start = std::max(sortedMapping[i].sourceRangeStart, coveredEnd);
+                long long int end = sortedMapping[i].sourceRangeStart + sortedMapping[i].rangeLength;
+                if(start >= end)
+                {
+                    continue;
+                }
+                addPiece(start, sortedMapping[i].destinationRangeStart - sortedMapping[i].sourceRangeStart);
+                addPiece(end, 0);
+                coveredEnd = end;
+            }
+        }
+
+
+        /*** Methods ***/
+        /**
+         * Returns the destination number that a source number is mapped to.
+        */
+        long long int map( long long int source ) const
+        {
+            return source + pieceOffsets[pieceIndex(source)];
+        }
+
+
+        /**
+         * Map every number in [start, end) and return the lowest destination, by brute force. The numbers are mapped
+         * in order, so rather than searching for each one's piece we walk forward through the pieces as we go. With
+         * AVX2 the numbers are mapped four at a time: every lane takes the offset of the piece holding the first number,
+         * and any lanes that have crossed into the pieces after it are compared against their starts and blended over
+         * to their offsets. The lowest destination is kept per lane until the end.
+        */
+        long long int lowestDestination(    long long int start,
+                                            long long int end ) const
+        {
+            long long int lowest = LLONG_MAX;
+            long long int source = start;
+            size_t piece = pieceIndex(source);
+#ifdef __AVX2__
+            __m256i sources = _mm256_setr_epi64x(source, source + 1, source + 2, source + 3);
+            const __m256i step = _mm256_set1_epi64x(4);
+            __m256i lowestLanes = _mm256_set1_epi64x(LLONG_MAX);
+            for(; source + 4 <= end; source += 4)
+            {
+                while( (piece + 1 < pieceStarts.size()) && (pieceStarts[piece + 1] <= source) )
+                {
+                    piece++;
+                }
+                __m256i offsets = _mm256_set1_epi64x(pieceOffsets[piece]);
+                for(size_t next = piece + 1; (next < pieceStarts.size()) && (pieceStarts[next] <= source + 3); next++)
+                {
+                    __m256i startsAfter = _mm256_cmpgt_epi64(_mm256_set1_epi64x(pieceStarts[next]), sources);
+                    offsets = _mm256_blendv_epi8(_mm256_set1_epi64x(pieceOffsets[next]), offsets, startsAfter);
+                }
+                __m256i destinations = _mm256_add_epi64(sources, offsets);
+                lowestLanes = _mm256_blendv_epi8(lowestLanes, destinations, _mm256_cmpgt_epi64(lowestLanes, destinations));
+                sources = _mm256_add_epi64(sources, step);
+            }
+            alignas(32) long long int lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), lowestLanes);
+            lowest = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+#endif
+            for(; source < end; source++)
+            {
+                while( (piece + 1 < pieceStarts.size()) && (pieceStarts[piece + 1] <= source) )
+                {
+                    piece++;
+                }
+                lowest = std::min(lowest, source + pieceOffsets[piece]);
+            }
+            return lowest;
+        }
+
+
+        /**
+         * Returns the lowest destination of any number in [start, end), without mapping the numbers one at a time.
+         * The interval is split at the starts of the pieces it overlaps, and the lowest destination in each part is
+         * its first number shifted by the piece's offset.
+        */
+        long long int lowestDestinationOfInterval(  long long int start,
+                                                    long long int end ) const
+        {
+            long long int lowest = LLONG_MAX;
+            for(size_t piece = pieceIndex(start); (piece < pieceStarts.size()) && (pieceStarts[piece] < end); piece++)
+            {
+                lowest = std::min(lowest, std::max(start, pieceStarts[piece]) + pieceOffsets[piece]);
+            }
+            return lowest;
+        }
+
+
+        /**
+         * Compose this table with the one after it, giving a single table that maps a number through this table and
+         * then through next. Each piece of this table is shifted by its offset and split at the starts of next's
+         * pieces, so the result has at most as many pieces as both tables put together.
+        */
+        MappingTable compose( const MappingTable & next ) const
+        {
+            MappingTable composed;
+            for(int i = 0; i < pieceStarts.size(); i++)
+            {
+                //The first and last pieces are gaps with an offset of 0, so only pieces with finite ends get shifted
+                long long int offset = pieceOffsets[i];
+                bool lastPiece = (i + 1 == pieceStarts.size());
+                long long int shiftedStart = pieceStarts[i] + offset;
+                long long int shiftedEnd = lastPiece ? LLONG_MAX : (pieceStarts[i+1] + offset);
+
+                //Start from the last of next's pieces that starts at or before this piece does, once shifted
+                int j = std::upper_bound(next.pieceStarts.begin(), next.pieceStarts.end(), shiftedStart) - next.pieceStarts.begin() - 1;
+                for(; (j < next.pieceStarts.size()) && (next.pieceStarts[j] < shiftedEnd); j++)
+                {
+                    composed.addPiece(std::max(shiftedStart, next.pieceStarts[j]) - offset, offset + next.pieceOffsets[j]);
+                }
+            }
+            return composed;
+        }
+
+    private:
+        //The index of the last piece starting at or before source, found with a branchless binary search. The first
+        //piece starts at LLONG_MIN, so there always is one.
+        size_t pieceIndex( long long int source ) const
+        {
+            const long long int * base = pieceStarts.data();
+            size_t count = pieceStarts.size();
+            while(count > 1)
+            {
+                size_t half = count / 2;
+                base = (base[half] <= source) ? (base + half) : base;
+                count -= half;
+            }
+            return base - pieceStarts.data();
+        }
+
+
+        //Start a new piece, replacing the last one if it would be empty and dropping it if it shifts by the same offset
+        void addPiece(  long long int start,
+                        long long int offset )
+        {
+            if(pieceStarts.back() == start)
+            {
+                pieceStarts.pop_back();
+                pieceOffsets.pop_back();
+            }
+            if(!pieceOffsets.empty() && (pieceOffsets.back() == offset))
+            {
+                return;
+            }
+            pieceStarts.push_back(start);
+            pieceOffsets.push_back(offset);
+        }
+};
+
+
+/**
+ * One stage of the almanac: the mapping ranges listed under one "<SOURCE>-to-<DESTINATION> map:" header, which map
+ * numbers of the source category (such as seed) to numbers of the destination category (such as soil).
+*/
+class AlmanacStage
+{
+    public:
+        /*** Variables ***/
+        std::string sourceCategory;
+        std::string destinationCategory;
+        std::vector<MappingRange> mappingRanges;
+
+        /*** Constructors ***/
+        //Default
+        AlmanacStage()
+        {
+        }
+
+
+        //Parametric
+        AlmanacStage(   std::string sourceCategoryParam,
+                        std::string destinationCategoryParam,
+                        std::vector<MappingRange> mappingRangesParam = {} )
+        {
+            sourceCategory = sourceCategoryParam;
+            destinationCategory = destinationCategoryParam;
+            mappingRanges = mappingRangesParam;
+        }
+
+
+        /*** Methods ***/
+        /**
+         * Returns true if any number is in more than one of the stage's mapping ranges. Ranges with no numbers in them
+         * are ignored.
+        */
+        bool hasOverlappingRanges() const
+        {
+            std::vector<MappingRange> sortedRanges = {};
+            for(int i = 0; i < mappingRanges.size(); i++)
+            {
+                if(mappingRanges[i].rangeLength > 0)
+                {
+                    sortedRanges.push_back(mappingRanges[i]);
+                }
+            }
+            std::sort(sortedRanges.begin(), sortedRanges.end(), [](const MappingRange & a, const MappingRange & b)
+            {
+                return a.sourceRangeStart < b.sourceRangeStart;
+            });
+            for(int i = 1; i < sortedRanges.size(); i++)
+            {
+                if(sortedRanges[i-1].sourceRangeStart + sortedRanges[i-1].rangeLength > sortedRanges[i].sourceRangeStart)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    private:
+};
+
+
+/**
+ * Class representing the chain of mappings (seed-to-soil, soil-to-fertilizer, and so on up to humidity-to-location) for
+ * all of the seeds on island island! The chain can have any number of stages, each mapping the previous stage's
+ * destination category to the next one, from seeds at the start to locations at the end.
+ * 
+ * Each stage can also be compiled into a MappingTable, and the stages composed into a single seed-to-location
+ * MappingTable. Both are built the first time they're asked for and kept for every lookup after that, so parts 1 and
+ * 2 and every benchmark iteration share them. The stages shouldn't be changed once they have been built.
 */
 class Almanac
 {
     public:
         /*** Variables ***/
-        std::vector<MappingRange> seed_to_soil;
-        std::vector<MappingRange> soil_to_fertilizer;
-        std::vector<MappingRange> fertilizer_to_water;
-        std::vector<MappingRange> water_to_light;
-        std::vector<MappingRange> light_to_temperature;
-        std::vector<MappingRange> temperature_to_humidity;
-        std::vector<MappingRange> humidity_to_location;
+        std::vector<AlmanacStage> stages;
 
         /*** Constructors ***/
         //Default
@@ -182,50 +396,199 @@ class Almanac
 
 
         //Parametric
-        Almanac(    std::vector<MappingRange> seed_to_soil_param,
-                    std::vector<MappingRange> soil_to_fertilizer_param,
-                    std::vector<MappingRange> fertilizer_to_water_param,
-                    std::vector<MappingRange> water_to_light_param,
-                    std::vector<MappingRange> light_to_temperature_param,
-                    std::vector<MappingRange> temperature_to_humidity_param,
-                    std::vector<MappingRange> humidity_to_location_param    )
+        Almanac( std::vector<AlmanacStage> stagesParam )
         {
-            seed_to_soil = seed_to_soil_param;
-            soil_to_fertilizer = soil_to_fertilizer_param;
-            fertilizer_to_water = fertilizer_to_water_param;
-            water_to_light = water_to_light_param;
-            light_to_temperature = light_to_temperature_param;
-            temperature_to_humidity = temperature_to_humidity_param;
-            humidity_to_location = humidity_to_location_param;
+            stages = stagesParam;
         }
 
 
         /*** Methods ***/
+        /**
+         * Returns the MappingTable of each stage, in the same order as the stages.
+        */
+        const std::vector<MappingTable> & getStageTables() const
+        {
+            if(!stageTables)
+            {
+                std::vector<MappingTable> tables = {};
+                for(int i = 0; i < stages.size(); i++)
+                {
+                    tables.push_back(MappingTable(stages[i].mappingRanges));
+                }
+                stageTables = tables;
+            }
+            return *stageTables;
+        }
+
+
+        /**
+         * Returns every stage composed into one table mapping seeds straight to locations.
+        */
+        const MappingTable & getSeedToLocation() const
+        {
+            if(!seedToLocation)
+            {
+                const std::vector<MappingTable> & tables = getStageTables();
+                MappingTable composed;
+                for(int i = 0; i < tables.size(); i++)
+                {
+                    composed = composed.compose(tables[i]);
+                }
+                seedToLocation = composed;
+            }
+            return *seedToLocation;
+        }
+
     private:
+        mutable std::optional<std::vector<MappingTable>> stageTables; //The cached result of getStageTables.
+        mutable std::optional<MappingTable> seedToLocation; //The cached result of getSeedToLocation.
+};
+
+
+/**
+ * A map from numbers to numbers that stores whole ranges of keys at once. Each entry is keyed by the start of a range
+ * and holds the range's length and the offset added to a key in the range to get its value, so its memory grows with
+ * the number of ranges rather than with how many keys they cover. Lookups behave like those of a
+ * std::map<long long int, long long int> holding every key of every range.
+*/
+class IntervalMap
+{
+    public:
+        /*** Methods ***/
+        /**
+         * Map every key in [start, start + length) to key + offset, replacing whatever those keys were mapped to before.
+        */
+        void assign(    long long int start,
+                        long long int length,
+                        long long int offset )
+        {
+            if(length <= 0)
+            {
+                return;
+            }
+            long long int end = start + length;
+
+            //Trim the range starting before this one, keeping any of it that sticks out past the end of this one
+            auto it = ranges.upper_bound(start);
+            if(it != ranges.begin())
+            {
+                auto before = std::prev(it);
+                long long int beforeEnd = before->first + before->second.first;
+                if(beforeEnd > start)
+                {
+                    before->second.first = start - before->first;
+                    if(beforeEnd > end)
+                    {
+                        ranges[end] = { beforeEnd - end, before->second.second };
+                    }
+                }
+            }
+
+            //Remove the ranges starting inside this one, keeping any of them that sticks out past the end of this one
+            for(it = ranges.lower_bound(start); (it != ranges.end()) && (it->first < end); it = ranges.erase(it))
+            {
+                long long int rangeEnd = it->first + it->second.first;
+                if(rangeEnd > end)
+                {
+                    ranges[end] = { rangeEnd - end, it->second.second };
+                }
+            }
+
+            //Finally, add this range
+            ranges[start] = { length, offset };
+        }
+
+
+        /**
+         * Returns 1 if key is mapped to a value, and 0 otherwise.
+        */
+        size_t count( long long int key ) const
+        {
+            return findRange(key) != ranges.end();
+        }
+
+
+        /**
+         * Returns true if key is mapped to a value.
+        */
+        bool contains( long long int key ) const
+        {
+            return count(key) == 1;
+        }
+
+
+        /**
+         * Returns the value that key is mapped to. Throws std::out_of_range if it isn't mapped to one.
+        */
+        long long int at( long long int key ) const
+        {
+            auto it = findRange(key);
+            if(it == ranges.end())
+            {
+                throw std::out_of_range("IntervalMap::at(): The key is not in the map");
+            }
+            return key + it->second.second;
+        }
+
+
+        /**
+         * Returns the number of keys that are mapped to a value.
+        */
+        long long int size() const
+        {
+            long long int keys = 0;
+            for(auto it = ranges.begin(); it != ranges.end(); it++)
+            {
+                keys += it->second.first;
+            }
+            return keys;
+        }
+
+
+        /**
+         * Returns true if no keys are mapped to a value.
+        */
+        bool empty() const
+        {
+            return ranges.empty();
+        }
+
+    private:
+        std::map<long long int, std::pair<long long int, long long int>> ranges; //Range start -> (range length, offset)
+
+        //The range holding key, or ranges.end() if there isn't one
+        std::map<long long int, std::pair<long long int, long long int>>::const_iterator findRange( long long int key ) const
+        {
+            auto it = ranges.upper_bound(key);
+            if(it == ranges.begin())
+            {
+                return ranges.end();
+            }
+            it--;
+            return (key < it->first + it->second.first) ? it : ranges.end();
+        }
 };
 
 
 /**
  * Given a vector of mapping range data, create a mapping of data from the source ranges to the destination ranges.
- * Return it as represented by a std::map<int,int>
+ * Return it as represented by an IntervalMap, which takes memory for each range instead of for each number in it.
+ * Where ranges overlap, the later one wins.
  * 
  * Parameter:
- *  std::vector<MappingRange> mappingData - A vector of MappingRange objects describing which source ranges are mapped to which destination ranges.
+ *  const std::vector<MappingRange> & mappingData - A vector of MappingRange objects describing which source ranges are mapped to which destination ranges.
  * 
  * Returns:
- *  std::map<int,int> - A map object describing the one-to-one relationships between a source number and a destination number from the mappingData parameter.
+ *  IntervalMap - A map object describing the one-to-one relationships between a source number and a destination number from the mappingData parameter.
 */
-std::map<long long int, long long int> createMapping( std::vector<MappingRange> mappingData)
+IntervalMap createMapping( const std::vector<MappingRange> & mappingData )
 {
-    std::map<long long int, long long int> mapping = {};
+    IntervalMap mapping;
 
-    //Now that our default mapping exists, we iterate through our mappingData and assign specific mappings
+    //Iterate through our mappingData and assign the mapping for each range
     for(int i = 0; i < mappingData.size(); i++)
     {
-        for(int k = 0; k < mappingData[i].rangeLength; k++)
-        {
-            mapping[mappingData[i].sourceRangeStart + k] = mappingData[i].destinationRangeStart + k;
-        }
+        mapping.assign(mappingData[i].sourceRangeStart, mappingData[i].rangeLength, mappingData[i].destinationRangeStart - mappingData[i].sourceRangeStart);
     }
 
     return mapping;
@@ -233,76 +596,155 @@ std::map<long long int, long long int> createMapping( std::vector<MappingRange>
 
 
 /**
- * Given a source value, find its mapping from a vector of mapping ranges from an almanac object.
+ * Given a source value, find its mapping from one stage of an almanac object, compiled into a MappingTable.
+ * Sources that aren't in any of the stage's mapping ranges are mapped to themselves.
  * 
  * Parameters:
  *  long long int source - The number we wish to find the mapping of within the almanacMapping.
- *  std::vector<MappingRange> almanacMapping - A vector of mapping ranges that contains the destination number for our source number.
+ *  const MappingTable & almanacMapping - The compiled mapping ranges that contain the destination number for our source number.
  * 
  * Returns:
  *  long long int - The destination number that our source number is mapped to.
 */
 long long int getAlmanacMapping(    long long int source, 
-                                    std::vector<MappingRange> almanacMapping)
+                                    const MappingTable & almanacMapping )
 {
-    //For every mapping range, check to see if the source is within the mapping range
-    bool foundMapping = false;
-    long long int destination;
-    for(int i = 0; i < almanacMapping.size(); i++)
-    {
-        if( in_range(source, almanacMapping[i].sourceRangeStart, (almanacMapping[i].sourceRangeStart + almanacMapping[i].rangeLength - 1), "inclusive") )
+    return almanacMapping.map(source);
+}
+
+
+/**
+ * A view of every seed in the seed ranges for part 2 of the day 5 problem, for a brute force solution. The seeds are
+ * generated one at a time as the view is iterated over, rather than stored, so it takes constant memory however many
+ * seeds the ranges hold. The view refers to the seeds vector it was made from, which must outlive it.
+*/
+class SeedRangeView
+{
+    public:
+        /**
+         * Steps through the seeds of each (range start, range length) pair in turn.
+        */
+        class Iterator
+        {
+            public:
+                using value_type = long long int;
+                using difference_type = std::ptrdiff_t;
+
+                Iterator()
+                {
+                }
+
+
+                Iterator(   const std::vector<long long int> * seedPairsParam,
+                            size_t pairIndexParam )
+                {
+                    seedPairs = seedPairsParam;
+                    pairIndex = pairIndexParam;
+                    skipEmptyRanges();
+                }
+
+
+                long long int operator*() const
+                {
+                    return (*seedPairs)[pairIndex] + offset;
+                }
+
+
+                Iterator & operator++()
+                {
+                    offset++;
+                    if(offset >= (*seedPairs)[pairIndex + 1])
+                    {
+                        pairIndex += 2;
+                        offset = 0;
+                        skipEmptyRanges();
+                    }
+                    return *this;
+                }
+
+
+                void operator++( int )
+                {
+                    ++*this;
+                }
+
+
+                bool operator==( const Iterator & other ) const
+                {
+                    return (pairIndex == other.pairIndex) && (offset == other.offset);
+                }
+
+            private:
+                const std::vector<long long int> * seedPairs = nullptr;
+                size_t pairIndex = 0; //The index of the current range start in seedPairs
+                long long int offset = 0; //How far into the current range we are
+
+                //Move past any ranges with no seeds in them
+                void skipEmptyRanges()
+                {
+                    while( (pairIndex + 1 < seedPairs->size()) && ((*seedPairs)[pairIndex + 1] <= 0) )
+                    {
+                        pairIndex += 2;
+                    }
+                }
+        };
+
+
+        /*** Constructors ***/
+        SeedRangeView( const std::vector<long long int> & seedPairsParam )
         {
-            //If the source is found within the mapping range, we find its destination
-            destination = almanacMapping[i].destinationRangeStart + (source - almanacMapping[i].sourceRangeStart);
-            //std::cout << "Calculating almanac mapping:" << source << " - " << almanacMapping[i].sourceRangeStart << " + " << almanacMapping[i].destinationRangeStart << " = " << destination << std::endl;
-            foundMapping = true;
+            seedPairs = &seedPairsParam;
+        }
+
+
+        /*** Methods ***/
+        Iterator begin() const
+        {
+            return Iterator(seedPairs, 0);
         }
-    }
-    if(!foundMapping)
-    {
-        //If we did not find the mapping for our source in our defined mapping ranges, then the source's destination is equal to itself.
-        destination = source;
-    }
 
-    return destination;
-}
+
+        Iterator end() const
+        {
+            //A trailing range start without a length is ignored
+            return Iterator(seedPairs, seedPairs->size() - (seedPairs->size() % 2));
+        }
+
+    private:
+        const std::vector<long long int> * seedPairs;
+};
 
 
 /**
- * Format the seeds vector for part 2 of the day 5 problem for a brute force solution.
+ * A half-open interval of numbers, [start, end). Used to push whole ranges of seeds through the almanac at once.
 */
-std::vector<long long int> part2_seedFormatting( std::vector<long long int> seeds )
+struct NumberInterval
 {
-    std::vector<long long int> seeds_formatted = {};
-    int activity = 1; 
-    long long int rangeStart;
-    long long int rangeLength;
+    long long int start;
+    long long int end;
+};
+
 
-    for(int i = 0; i < seeds.size(); i++)
+/**
+ * Turn the (range start, range length) pairs from the seeds line into intervals of seeds for part 2 of the day 5 problem.
+ * 
+ * Parameter:
+ *  const std::vector<long long int> & seeds - The numbers from the seeds line, as pairs of range starts and range lengths.
+ * 
+ * Returns:
+ *  std::vector<NumberInterval> - The seed intervals. Empty ranges are left out.
+*/
+std::vector<NumberInterval> seedPairsToIntervals( const std::vector<long long int> & seeds )
+{
+    std::vector<NumberInterval> intervals = {};
+    for(int i = 0; i + 1 < seeds.size(); i += 2)
     {
-        switch(activity)
-        {
-            //Identify range start
-            case 1:
-                rangeStart = seeds[i];
-                activity = 2;
-                break;
-            //Identify range length and push seed numbers to the seeds_formatted vector
-            case 2:
-                rangeLength = seeds[i];
-                for(long long int s = 0; s < rangeLength; s++)
-                {
-                    seeds_formatted.push_back(rangeStart + s);
-                }
-                activity = 1;
-                break;
-            default:
-                break;
+        if(seeds[i+1] > 0)
+        {
+            intervals.push_back({ seeds[i], seeds[i] + seeds[i+1] });
         }
     }
-
-    std::cout << "Done formatting seeds for p2!" << std::endl;
-    return seeds_formatted;
+    return intervals;
 }
 
 
@@ -310,8 +752,7 @@ std::vector<long long int> part2_seedFormatting( std::vector<long long int> seed
  * Given the input for advent of code 2023 day 5, read it into the program. We'll store it as a tuple
  * of a std::vector<int> and an Almanac.
 */
-std::tuple<std::vector<long long int>, Almanac> readInput(  std::string inputFileName,
-                                                            std::string partToExecute )
+std::tuple<std::vector<long long int>, Almanac> readInput(  std::string inputFileName )
 {
     //Open the file
     std::fstream file(inputFileName);
@@ -326,239 +767,348 @@ std::tuple<std::vector<long long int>, Almanac> readInput(  std::string inputFil
 
     //Now we'll iterate through the file
     std::string line;
-    int activity = 0; //Looking to identify the next activity
     //First, we'll read in the seeds from the first line
     std::vector<long long int> seeds = {};
-    //After that, we'll start populating the mapping vairbles in the Almanac
-    std::vector<MappingRange> mappingData = {};
+    //After that, each "<SOURCE>-to-<DESTINATION> map:" header starts a new stage of the Almanac, and the lines under it
+    //are its mapping ranges
     Almanac almanac = Almanac();
     while( getline(file, line) )
     {
-        switch(activity)
+        //Skip lines with no content
+        if(stringLib.trimWhitespace(line).empty())
         {
-            //Looking to identify the next activity
-            case 0:
-                //Check if the line has any content
-                if(!line.empty())
-                {
-                    //Find how the line is labeled
-                    std::vector<std::string> separatedLabelLine = stringLib.separate(line, ":");
-                    std::string label = separatedLabelLine[0];
-                    if(label == "seeds")
-                    {
-                        //Read the seeds in from  this line
-                        seeds = vecOfStrings_to_vecOfLongLongInts( stringLib.separate( stringLib.trimWhitespace(separatedLabelLine[1]), " ") );
-                        if( partToExecute == "2")
-                        {
-                            seeds = part2_seedFormatting(seeds);
-                        }
-                        
-                    }
-                    else if(label == "seed-to-soil map")
-                    {
-                        //Switch to processing seed-to-soil mapping
-                        activity = 1;
-                    }
-                    else if(label == "soil-to-fertilizer map")
-                    {
-                        //Switch to processing soil-to-fertilizer mapping
-                        activity = 2;
-                    }
-                    else if(label == "fertilizer-to-water map")
-                    {
-                        //Switch to processing fertilizer-to-water mapping
-                        activity = 3;
-                    }
-                    else if(label == "water-to-light map")
-                    {
-                        //Switch to processing water-to-light mapping
-                        activity = 4;
-                    }
-                    else if(label == "light-to-temperature map")
-                    {
-                        //Switch to processing light-to-temperature mappping
-                        activity = 5;
-                    }
-                    else if(label == "temperature-to-humidity map")
-                    {
-                        //Switch to processing temperature-to-humidity mapping
-                        activity = 6;
-                    }
-                    else if(label == "humidity-to-location map")
-                    {
-                        //Swtich to processing humidity-to-location mapping
-                        activity = 7;
-                    }
-                    mappingData.clear();
-                }
-                else
-                {
-                    //No content in this line. Go to the next one and look there.
-                    continue;
-                }
-                break;
-            //Create seed-to-soil mapping
-            case 1:
-                //If the line contains content
-                if(!line.empty())
-                {
-                    //Store the data from the line in a mapping range object
-                    std::vector<long long int> lineData = vecOfStrings_to_vecOfLongLongInts(stringLib.separate(line, " "));
-                    mappingData.push_back(MappingRange(lineData[0], lineData[1], lineData[2]));
-                }
-                else
-                {
-                    almanac.seed_to_soil = mappingData;
-                    activity = 0;
-                    //std::cout << "Size of seed to soil: " << almanac.seed_to_soil.size() << std::endl;
-                }
-                break;
-            //Create soil-to-fertilizer mapping
-            case 2:
-                //If the line contains content
-                if(!line.empty())
-                {
-                    //Store the data from the line in a mapping range object
-                    std::vector<long long int> lineData = vecOfStrings_to_vecOfLongLongInts(stringLib.separate(line, " "));
-                    mappingData.push_back(MappingRange(lineData[0], lineData[1], lineData[2]));
-                }
-                else
-                {
-                    almanac.soil_to_fertilizer = mappingData;
-                    activity = 0;
-                    //std::cout << "Size of soil to fertilizer: " << almanac.soil_to_fertilizer.size() << std::endl;
-                }
-                break;
-            //Create fertilizer-to-water mapping
-            case 3:
-                //If the line contains content
-                if(!line.empty())
-                {
-                    //Store the data from the line in a mapping range object
-                    std::vector<long long int> lineData = vecOfStrings_to_vecOfLongLongInts(stringLib.separate(line, " "));
-                    mappingData.push_back(MappingRange(lineData[0], lineData[1], lineData[2]));
-                }
-                else
-                {
-                    almanac.fertilizer_to_water = mappingData;
-                    activity = 0;
-                    //std::cout << "Size of fertilizer to water: " << almanac.fertilizer_to_wcater.size() << std::endl;
-                }
-                break;
-            //Create water-to-light mapping
-            case 4:
-                //If the line contains content
-                if(!line.empty())
-                {
-                    //Store the data from the line in a mapping range object
-                    std::vector<long long int> lineData = vecOfStrings_to_vecOfLongLongInts(stringLib.separate(line, " "));
-                    mappingData.push_back(MappingRange(lineData[0], lineData[1], lineData[2]));
-                }
-                else
-                {
-                    almanac.water_to_light = mappingData;
-                    activity = 0;
-                }
-                break;
-            //Create light-to-temperature mapping
-            case 5:
-                //If the line contains content
-                if(!line.empty())
-                {
-                    //Store the data from the line in a mapping range object
-                    std::vector<long long int> lineData = vecOfStrings_to_vecOfLongLongInts(stringLib.separate(line, " "));
-                    mappingData.push_back(MappingRange(lineData[0], lineData[1], lineData[2]));
-                }
-                else
-                {
-                    almanac.light_to_temperature = mappingData;
-                    activity = 0;
-                }
-                break;
-            //Create temperature-to-humidity mapping
-            case 6:
-                //If the line contains content
-                if(!line.empty())
-                {
-                    //Store the data from the line in a mapping range object
-                    std::vector<long long int> lineData = vecOfStrings_to_vecOfLongLongInts(stringLib.separate(line, " "));
-                    mappingData.push_back(MappingRange(lineData[0], lineData[1], lineData[2]));
-                }
-                else
-                {
-                    almanac.temperature_to_humidity = mappingData;
-                    activity = 0;
-                }
-                break;
-            //Create humidity-to-location mapping
-            case 7:
-                //If the line contains content
-                if(!line.empty())
-                {
-                    //Store the data from the line in a mapping range object
-                    std::vector<long long int> lineData = vecOfStrings_to_vecOfLongLongInts(stringLib.separate(line, " "));
-                    mappingData.push_back(MappingRange(lineData[0], lineData[1], lineData[2]));
-                }
-                // else
-                // {
-                //     
-                //     activity = 0;
-                // }
-                break;
-            default:
-                //std::cout << "Hitting the default case" << std::endl;
-                break;
+            continue;
+        }
+
+        //Find how the line is labeled
+        std::vector<std::string> separatedLabelLine = stringLib.separate(line, ":");
+        std::string label = separatedLabelLine[0];
+        if(label == "seeds")
+        {
+            //Read the seeds in from  this line
+            seeds = vecOfStrings_to_vecOfLongLongInts( stringLib.separate( stringLib.trimWhitespace(separatedLabelLine[1]), " ") );
+        }
+        else if(line.find(":") != std::string::npos)
+        {
+            //A map header. Its label is "<SOURCE>-to-<DESTINATION> map".
+            size_t to = label.find("-to-");
+            size_t mapSuffix = label.rfind(" map");
+            if( (to == std::string::npos) || (mapSuffix == std::string::npos) || (mapSuffix < to) )
+            {
+                std::cout << "There was a problem and we could not read the almanac map header:'" << line << "'" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            std::string sourceCategory = label.substr(0, to);
+            std::string destinationCategory = label.substr(to + 4, mapSuffix - (to + 4));
+
+            //Each stage has to pick up where the one before it left off
+            if(!almanac.stages.empty() && (almanac.stages.back().destinationCategory != sourceCategory))
+            {
+                std::cout << "There was a problem and the almanac map '" << label << "' does not follow on from the '"
+                          << almanac.stages.back().destinationCategory << "' category before it." << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            almanac.stages.push_back(AlmanacStage(sourceCategory, destinationCategory));
+        }
+        else if(!almanac.stages.empty())
+        {
+            //Store the data from the line in a mapping range object in the current stage
+            std::vector<long long int> lineData = vecOfStrings_to_vecOfLongLongInts(stringLib.separate(stringLib.trimWhitespace(line), " "));
+            almanac.stages.back().mappingRanges.push_back(MappingRange(lineData[0], lineData[1], lineData[2]));
+        }
+    }
+
+    //Every way of answering the problem assumes a number is in at most one mapping range of a stage
+    for(int i = 0; i < almanac.stages.size(); i++)
+    {
+        if(almanac.stages[i].hasOverlappingRanges())
+        {
+            std::cout << "There was a problem and the mapping ranges of the almanac map '" << almanac.stages[i].sourceCategory
+                      << "-to-" << almanac.stages[i].destinationCategory << " map' overlap." << std::endl;
+            exit(EXIT_FAILURE);
         }
     }
-    almanac.humidity_to_location = mappingData;
 
     return std::make_tuple(seeds, almanac);
 }
 
 
 /**
- * Given a vector of seeds, run through the convoluted process of looking through seed mappings in the almanac to 
+ * Given some seeds, run through the convoluted process of looking through seed mappings in the almanac to 
  * find the closest (lowest) location number that any one of the seeds are mapped to, then return the lowest location
  * number.
  * 
  * Parameters:
- *  std::vector<int> seeds - A vector of integers describing the id numbers of seeds we are looking up the location numbers of.
- *  Almanac almanac - The agricultural almanac for island island, describing how different agricultural materials are mapped to eachother.
+ *  const SeedSource & seeds - The id numbers of seeds we are looking up the location numbers of. Anything that can be
+ *                             iterated over for seeds: a std::vector<long long int> for part 1, or a SeedRangeView for part 2.
+ *  const Almanac & almanac - The agricultural almanac for island island, describing how different agricultural materials are mapped to eachother.
  * 
  * Returns:
- *  int - The lowest location number that is mapped to one of the elements from the seeds vector.
+ *  long long int - The lowest location number that is mapped to one of the seeds.
 */
-int findClosestSeedLocation(    std::vector<long long int> seeds,
-                                Almanac almanac )
+template<typename SeedSource>
+long long int findClosestSeedLocation(  const SeedSource & seeds,
+                                        const Almanac & almanac )
 {
-    std::vector<long long int> locations = {};
+    //Every stage of the almanac composed into one, so each seed takes a single lookup
+    const MappingTable & seed_to_location = almanac.getSeedToLocation();
+
+    //For each of our seeds, find its location and keep track of the lowest one
+    bool foundSeed = false;
+    long long int closestLocation = LLONG_MAX;
+    for(long long int seed : seeds)
+    {
+        closestLocation = std::min(closestLocation, getAlmanacMapping(seed, seed_to_location));
+        foundSeed = true;
+    }
+    if(!foundSeed)
+    {
+        std::cerr << "findClosestSeedLocation(): There must be at least one seed" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    return closestLocation;
+}
+
+
+/**
+ * Part 2 of the day 5 problem by brute force, spread across threadCount threads. Every seed is mapped through the
+ * composed seed-to-location table, four at a time with AVX2, by MappingTable::lowestDestination. The seed ranges are cut into chunks that the
+ * threads take from a shared counter as they go, and each thread keeps its own running minimum until it runs out of
+ * chunks. While they work, the calling thread reports how many seeds have been mapped per second.
+ * 
+ * Parameters:
+ *  const std::vector<long long int> & seeds - The numbers from the seeds line, as pairs of range starts and range lengths.
+ *  const Almanac & almanac - The agricultural almanac for island island.
+ *  int threadCount - The number of threads to use.
+ * 
+ * Returns:
+ *  long long int - The lowest location number that is mapped to one of the seeds in the seed ranges.
+*/
+long long int findClosestSeedLocationParallel(  const std::vector<long long int> & seeds,
+                                                const Almanac & almanac,
+                                                int threadCount )
+{
+    //Build the composed table before any thread asks for it
+    const MappingTable & seed_to_location = almanac.getSeedToLocation();
+
+    //Cut the seed ranges into chunks small enough to share out evenly
+    const long long int chunkSize = 1 << 22;
+    std::vector<NumberInterval> chunks = {};
+    long long int totalSeeds = 0;
+    std::vector<NumberInterval> seedIntervals = seedPairsToIntervals(seeds);
+    for(int i = 0; i < seedIntervals.size(); i++)
+    {
+        for(long long int chunkStart = seedIntervals[i].start; chunkStart < seedIntervals[i].end; chunkStart += chunkSize)
+        {
+            chunks.push_back({ chunkStart, std::min(chunkStart + chunkSize, seedIntervals[i].end) });
+        }
+        totalSeeds += seedIntervals[i].end - seedIntervals[i].start;
+    }
+    if(chunks.empty())
+    {
+        std::cerr << "findClosestSeedLocationParallel(): There must be at least one seed" << std::endl;
+        exit(EXIT_FAILURE);
+    }
 
-    long long int soil, fertilizer, water, light, temperature, humidity, location;
+    threadCount = std::max(1, std::min<int>(threadCount, chunks.size()));
+    std::atomic<size_t> nextChunk = 0;
+    std::atomic<long long int> seedsMapped = 0;
+    std::vector<long long int> closestLocations(threadCount, LLONG_MAX);
+    int finishedThreads = 0;
+    std::mutex finishedMutex;
+    std::condition_variable finishedCondition;
 
-    //For each of our seeds, find its location
-    for(int i = 0; i < seeds.size(); i++)
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads = {};
+    for(int t = 0; t < threadCount; t++)
     {
-        soil = getAlmanacMapping(seeds[i], almanac.seed_to_soil);
-        //std::cout << "Seed " << seeds[i] << "\n-> Soil " << soil << std::endl;
-        fertilizer = getAlmanacMapping(soil, almanac.soil_to_fertilizer);
-        //std::cout << "-> Fertilizer " << fertilizer << std::endl;
-        water = getAlmanacMapping(fertilizer, almanac.fertilizer_to_water);
-        //std::cout << "-> Water " << water << std::endl; 
-        light = getAlmanacMapping(water, almanac.water_to_light);
-        //std::cout << "-> Light " << light << std::endl;
-        temperature = getAlmanacMapping(light, almanac.light_to_temperature);
-        //std::cout << "-> Temperature  " << temperature << std::endl;
-        humidity = getAlmanacMapping(temperature, almanac.temperature_to_humidity);
-        //std::cout << "-> Humidity " << humidity << std::endl;
-        location = getAlmanacMapping(humidity, almanac.humidity_to_location);
-        //std::cout << "-> LOCATION OF SEED " << seeds[i] << ": " << location << "\n" << std::endl;
-        locations.push_back(location);
+        threads.emplace_back([&, t]()
+        {
+            long long int closestLocation = LLONG_MAX;
+            for(size_t chunk = nextChunk++; chunk < chunks.size(); chunk = nextChunk++)
+            {
+                closestLocation = std::min(closestLocation, seed_to_location.lowestDestination(chunks[chunk].start, chunks[chunk].end));
+                seedsMapped += chunks[chunk].end - chunks[chunk].start;
+            }
+            closestLocations[t] = closestLocation;
+
+            std::lock_guard<std::mutex> lock(finishedMutex);
+            finishedThreads++;
+            finishedCondition.notify_one();
+        });
     }
 
+    //Report progress every second until every thread is done
+    {
+        std::unique_lock<std::mutex> lock(finishedMutex);
+        while(!finishedCondition.wait_for(lock, std::chrono::seconds(1), [&]() { return finishedThreads == threadCount; }))
+        {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "Mapped " << seedsMapped << " of " << totalSeeds << " seeds (" << (long long int)(seedsMapped / seconds) << " seeds/sec)" << std::endl;
+        }
+    }
+    for(int t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Mapped all " << totalSeeds << " seeds on " << threadCount << " threads (" << (long long int)(totalSeeds / std::max(seconds, 1e-9)) << " seeds/sec)" << std::endl;
+
+    return *std::min_element(closestLocations.begin(), closestLocations.end());
+}
+
+
+/**
+ * Part 2 of the day 5 problem, without looking at the seeds one at a time: split each seed interval against the pieces
+ * of the almanac's cached seed-to-location table, and take the lowest location of the parts. The work depends on the
+ * number of intervals and pieces, not on how many seeds the intervals hold.
+ * 
+ * Parameters:
+ *  const std::vector<long long int> & seeds - The numbers from the seeds line, as pairs of range starts and range lengths.
+ *  const Almanac & almanac - The agricultural almanac for island island.
+ * 
+ * Returns:
+ *  long long int - The lowest location number that is mapped to one of the seeds in the seed ranges.
+*/
+long long int findClosestSeedRangeLocation( const std::vector<long long int> & seeds,
+                                            const Almanac & almanac )
+{
+    const MappingTable & seed_to_location = almanac.getSeedToLocation();
+    std::vector<NumberInterval> intervals = seedPairsToIntervals(seeds);
+
+    std::vector<long long int> locations = {};
+    for(int i = 0; i < intervals.size(); i++)
+    {
+        locations.push_back(seed_to_location.lowestDestinationOfInterval(intervals[i].start, intervals[i].end));
+    }
     return find_min(locations);
 }
 
 
+/**
+ * Numbers in the half-open interval [start, end) at some stage of the almanac, which end up at the location number
+ * shift more than themselves. Used to follow intervals of locations back to the seeds they came from.
+*/
+struct LocatedInterval
+{
+    long long int start;
+    long long int end;
+    long long int shift;
+};
+
+
+/**
+ * Given some intervals of destination numbers for one stage of the almanac, find the intervals of source numbers that
+ * are mapped into them. Each piece of the stage's table is shifted by its offset and overlapped with each interval,
+ * and the overlap is shifted back to the source numbers that land in it.
+ * A destination interval can come from more than one piece, or from none.
+ * 
+ * Parameters:
+ *  const std::vector<LocatedInterval> & intervals - The intervals of destination numbers.
+ *  const MappingTable & almanacMapping - The compiled mapping ranges of the stage.
+ * 
+ * Returns:
+ *  std::vector<LocatedInterval> - The intervals of source numbers, with their shifts updated to match.
+*/
+std::vector<LocatedInterval> unmapIntervalsThroughStage(    const std::vector<LocatedInterval> & intervals,
+                                                            const MappingTable & almanacMapping )
+{
+    //Shift a bound back by a piece's offset. The unbounded ends of the number line stay unbounded.
+    auto unshift = [](long long int bound, long long int offset)
+    {
+        return ((bound == LLONG_MIN) || (bound == LLONG_MAX)) ? bound : (bound - offset);
+    };
+
+    std::vector<LocatedInterval> sourceIntervals = {};
+    for(int i = 0; i < intervals.size(); i++)
+    {
+        for(int p = 0; p < almanacMapping.pieceStarts.size(); p++)
+        {
+            long long int offset = almanacMapping.pieceOffsets[p];
+            long long int pieceEnd = (p + 1 < almanacMapping.pieceStarts.size()) ? almanacMapping.pieceStarts[p+1] : LLONG_MAX;
+            long long int start = std::max(unshift(intervals[i].start, offset), almanacMapping.pieceStarts[p]);
+            long long int end = std::min(unshift(intervals[i].end, offset), pieceEnd);
+            if(start < end)
+            {
+                sourceIntervals.push_back({ start, end, intervals[i].shift + offset });
+            }
+        }
+    }
+    return sourceIntervals;
+}
+
+
+/**
+ * Part 2 of the day 5 problem, searching backwards from the locations. The location numbers are split into intervals
+ * at the ends of the last stage's destination ranges, and the intervals are taken in increasing order. Each one is
+ * followed back through every stage to the seed numbers that reach it, and checked against the seed ranges. The first
+ * interval that any seed reaches holds the answer, so the search stops there without looking at the rest.
+ * 
+ * Parameters:
+ *  const std::vector<long long int> & seeds - The numbers from the seeds line, as pairs of range starts and range lengths.
+ *  const Almanac & almanac - The agricultural almanac for island island.
+ * 
+ * Returns:
+ *  long long int - The lowest location number that is mapped to one of the seeds in the seed ranges.
+*/
+long long int findClosestSeedLocationReverse(   const std::vector<long long int> & seeds,
+                                                const Almanac & almanac )
+{
+    std::vector<NumberInterval> seedIntervals = seedPairsToIntervals(seeds);
+    const std::vector<MappingTable> & stageTables = almanac.getStageTables();
+
+    //Split the locations at the ends of the last stage's pieces, once they're shifted to their destinations
+    std::vector<long long int> locationBounds = { LLONG_MIN, LLONG_MAX };
+    if(!stageTables.empty())
+    {
+        const MappingTable & lastStage = stageTables.back();
+        for(int p = 1; p < lastStage.pieceStarts.size(); p++)
+        {
+            locationBounds.push_back(lastStage.pieceStarts[p] + lastStage.pieceOffsets[p]);
+            locationBounds.push_back(lastStage.pieceStarts[p] + lastStage.pieceOffsets[p-1]);
+        }
+    }
+    std::sort(locationBounds.begin(), locationBounds.end());
+    locationBounds.erase(std::unique(locationBounds.begin(), locationBounds.end()), locationBounds.end());
+
+    //Walk the location intervals from lowest to highest
+    for(int i = 0; i + 1 < locationBounds.size(); i++)
+    {
+        std::vector<LocatedInterval> intervals = { { locationBounds[i], locationBounds[i+1], 0 } };
+        for(int stage = stageTables.size() - 1; (stage >= 0) && !intervals.empty(); stage--)
+        {
+            intervals = unmapIntervalsThroughStage(intervals, stageTables[stage]);
+        }
+
+        //Every location in this interval is lower than any in the intervals after it, so the lowest seed that
+        //reaches it is the answer
+        bool foundSeed = false;
+        long long int closestLocation = LLONG_MAX;
+        for(int j = 0; j < intervals.size(); j++)
+        {
+            for(int k = 0; k < seedIntervals.size(); k++)
+            {
+                long long int start = std::max(intervals[j].start, seedIntervals[k].start);
+                long long int end = std::min(intervals[j].end, seedIntervals[k].end);
+                if(start < end)
+                {
+                    closestLocation = std::min(closestLocation, start + intervals[j].shift);
+                    foundSeed = true;
+                }
+            }
+        }
+        if(foundSeed)
+        {
+            return closestLocation;
+        }
+    }
+
+    std::cerr << "findClosestSeedLocationReverse(): There must be at least one seed" << std::endl;
+    exit(EXIT_FAILURE);
+}
+
+
 int main( int argc, char * argv[] )
 {
    InputParser inputParser =  InputParser(argc, argv);
@@ -586,7 +1136,7 @@ int main( int argc, char * argv[] )
     if(partToExecute == "1")
     {
         //Read in the file
-        std::tuple< std::vector<long long int>, Almanac > seedsAndAlmanac = readInput( inputFileName, partToExecute );
+        std::tuple< std::vector<long long int>, Almanac > seedsAndAlmanac = readInput( inputFileName );
         std::vector<long long int> seeds = get<0>(seedsAndAlmanac);
         Almanac almanac = get<1>(seedsAndAlmanac);
 
@@ -605,33 +1155,89 @@ int main( int argc, char * argv[] )
         //Execute normally
         else
         {
-            int answer = findClosestSeedLocation(seeds, almanac);
+            long long int answer = findClosestSeedLocation(seeds, almanac);
             std::cout << "Closest (lowest) seed location: " << answer << std::endl;
         }
     }
     if(partToExecute == "2")
     {
         //Read in the file
-        std::tuple< std::vector<long long int>, Almanac> seedsAndAlmanac = readInput( inputFileName, partToExecute );
+        std::tuple< std::vector<long long int>, Almanac> seedsAndAlmanac = readInput( inputFileName );
         std::vector<long long int> seeds = get<0>(seedsAndAlmanac);
         Almanac almanac = get<1>(seedsAndAlmanac);
 
+        //Use -b to check every seed one at a time, instead of mapping the seed ranges as intervals. Add -j <THREADS>
+        //to spread the seeds across multiple threads. 0 uses every available core.
+        bool bruteForce = inputParser.cmdOptionExists("-b");
+        //Use -r to search backwards from the lowest locations instead
+        bool reverse = inputParser.cmdOptionExists("-r");
+        int threadCount = 0;
+        if(inputParser.cmdOptionExists("-j"))
+        {
+            threadCount = std::stoi(inputParser.getCmdOption("-j"));
+            if(threadCount <= 0)
+            {
+                threadCount = std::max(1u, std::thread::hardware_concurrency());
+            }
+        }
+
+        //Find the average time of the execution
+        if(inputParser.cmdOptionExists("-t") && !bruteForce)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            for(int i = 0; i < 1000; i++)
+            {
+                if(reverse)
+                {
+                    findClosestSeedLocationReverse( seeds, almanac );
+                }
+                else
+                {
+                    findClosestSeedRangeLocation( seeds, almanac );
+                }
+            }
+            auto stop = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+            std::cout << "The average exeuction time of AoC day 5, part 2 (microseconds): " << ((duration.count() /1000)) << std::endl;
+        }
         //Find the time of execution
-        if(inputParser.cmdOptionExists("-t"))
+        else if(inputParser.cmdOptionExists("-t"))
         {
             auto start = std::chrono::high_resolution_clock::now();
             // for(int i = 0; i < 1; i++)
             // {
-                findClosestSeedLocation( seeds, almanac );
+                if(threadCount > 0)
+                {
+                    findClosestSeedLocationParallel( seeds, almanac, threadCount );
+                }
+                else
+                {
+                    findClosestSeedLocation( SeedRangeView(seeds), almanac );
+                }
             // }
             auto stop = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
             std::cout << "The exeuction time of AoC day 5, part 2 (microseconds): " << ((duration.count() /1000)) << std::endl;
         }
         //Execute normally
+        else if(bruteForce && (threadCount > 0))
+        {
+            long long int answer = findClosestSeedLocationParallel(seeds, almanac, threadCount);
+            std::cout << "Closest (lowest) seed location: " << answer << std::endl;
+        }
+        else if(bruteForce)
+        {
+            long long int answer = findClosestSeedLocation(SeedRangeView(seeds), almanac);
+            std::cout << "Closest (lowest) seed location: " << answer << std::endl;
+        }
+        else if(reverse)
+        {
+            long long int answer = findClosestSeedLocationReverse(seeds, almanac);
+            std::cout << "Closest (lowest) seed location: " << answer << std::endl;
+        }
         else
         {
-            int answer = findClosestSeedLocation(seeds, almanac);
+            long long int answer = findClosestSeedRangeLocation(seeds, almanac);
             std::cout << "Closest (lowest) seed location: " << answer << std::endl;
         }
     }